@@ -0,0 +1,265 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ *  \file BVH.h
+ *  \brief Bounding volume hierarchy over a set of primitives
+ *  \author Bastien Durix
+ */
+
+#ifndef _BVH_H_
+#define _BVH_H_
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <Eigen/Dense>
+
+/**
+ *  \brief Lots of algorithms
+ */
+namespace algorithm
+{
+	/**
+	 *  \brief Evaluation algorithms
+	 */
+	namespace evaluation
+	{
+		/**
+		 *  \brief Bounding volume hierarchy over a set of primitives
+		 *
+		 *  \details Binary tree of axis aligned boxes, split at the median of the primitives box centers on the
+		 *           longest axis. Distance queries skip the subtrees whose box is farther than the current minimum.
+		 *
+		 *  \tparam Primitive indexed primitive, giving its bounding box (getMin and getMax) and its distance to a
+		 *                    point (distance), which has to be at least the distance to its box
+		 */
+		template<typename Primitive>
+		class BVH
+		{
+			public:
+				/**
+				 *  \brief Hierarchy shared pointer
+				 */
+				using Ptr = std::shared_ptr<BVH<Primitive> >;
+
+				/**
+				 *  \brief Maximal number of primitives in a leaf
+				 */
+				static const unsigned int LeafSize = 4;
+
+				/**
+				 *  \brief Size of the traversal stack of the queries
+				 *
+				 *  \details Median splits give a depth of at most 32 for 32 bits indices, and a depth first
+				 *           traversal holds at most one node more than the depth
+				 */
+				static const unsigned int StackSize = 64;
+
+			protected:
+				/**
+				 *  \brief Node of the hierarchy
+				 */
+				struct Node
+				{
+					/**
+					 *  \brief Lower corner of the bounding box
+					 */
+					Eigen::Vector2d ptmin;
+
+					/**
+					 *  \brief Upper corner of the bounding box
+					 */
+					Eigen::Vector2d ptmax;
+
+					/**
+					 *  \brief First primitive of the node (leaf) or index of the first child (inner node)
+					 */
+					unsigned int first;
+
+					/**
+					 *  \brief Number of primitives (leaf), 0 for inner nodes
+					 */
+					unsigned int nbprimitives;
+				};
+
+				/**
+				 *  \brief Nodes of the hierarchy, root first, children stored side by side
+				 */
+				std::vector<Node> m_nodes;
+
+				/**
+				 *  \brief Primitives, sorted by leaf
+				 */
+				std::vector<Primitive> m_primitives;
+
+				/**
+				 *  \brief Distance between a point and a box
+				 *
+				 *  \param pt    point
+				 *  \param ptmin lower corner of the box
+				 *  \param ptmax upper corner of the box
+				 *
+				 *  \return distance to the box (0 inside)
+				 */
+				static inline double BoxDist(const Eigen::Vector2d &pt, const Eigen::Vector2d &ptmin, const Eigen::Vector2d &ptmax)
+				{
+					Eigen::Vector2d vec = (ptmin - pt).cwiseMax(pt - ptmax).cwiseMax(Eigen::Vector2d::Zero());
+					return vec.norm();
+				}
+
+				/**
+				 *  \brief Builds the hierarchy over the primitives
+				 */
+				void build()
+				{
+					m_nodes.resize(0);
+					if(m_primitives.size() == 0)
+						return;
+
+					std::vector<unsigned int> vecind(m_primitives.size());
+					for(unsigned int i = 0; i < vecind.size(); i++)
+						vecind[i] = i;
+
+					// nodes to split: node index, first and last primitive (in vecind)
+					struct Range { unsigned int node, beg, end; };
+					std::vector<Range> vecrange(1,Range{0,0,(unsigned int)vecind.size()});
+					m_nodes.resize(1);
+
+					while(vecrange.size() != 0)
+					{
+						Range range = vecrange.back();
+						vecrange.pop_back();
+
+						Node &node = m_nodes[range.node];
+						node.ptmin = m_primitives[vecind[range.beg]].getMin();
+						node.ptmax = m_primitives[vecind[range.beg]].getMax();
+						for(unsigned int i = range.beg+1; i < range.end; i++)
+						{
+							node.ptmin = node.ptmin.cwiseMin(m_primitives[vecind[i]].getMin());
+							node.ptmax = node.ptmax.cwiseMax(m_primitives[vecind[i]].getMax());
+						}
+
+						if(range.end - range.beg <= LeafSize)
+						{
+							node.first = range.beg;
+							node.nbprimitives = range.end - range.beg;
+							continue;
+						}
+
+						// median split on the longest axis
+						unsigned int axis = (node.ptmax - node.ptmin).x() >= (node.ptmax - node.ptmin).y() ? 0 : 1;
+						unsigned int mid = (range.beg + range.end) / 2;
+						std::nth_element(vecind.begin() + range.beg, vecind.begin() + mid, vecind.begin() + range.end,
+										 [this,axis](unsigned int i1, unsigned int i2)
+										 {
+											 return m_primitives[i1].getMin()(axis) + m_primitives[i1].getMax()(axis) <
+													m_primitives[i2].getMin()(axis) + m_primitives[i2].getMax()(axis);
+										 });
+
+						unsigned int child = m_nodes.size();
+						node.first = child;
+						node.nbprimitives = 0;
+						m_nodes.resize(child + 2);
+						vecrange.push_back(Range{child,range.beg,mid});
+						vecrange.push_back(Range{child+1,mid,range.end});
+					}
+
+					// primitives sorted by leaf
+					std::vector<Primitive> primitives(m_primitives.size());
+					for(unsigned int i = 0; i < vecind.size(); i++)
+						primitives[i] = m_primitives[vecind[i]];
+					m_primitives.swap(primitives);
+				}
+
+			public:
+				/**
+				 *  \brief Constructor
+				 *
+				 *  \param primitives indexed primitives
+				 */
+				BVH(const std::vector<Primitive> &primitives = std::vector<Primitive>(0)) :
+					m_nodes(0), m_primitives(primitives)
+				{
+					build();
+				}
+
+				/**
+				 *  \brief Number of primitives getter
+				 *
+				 *  \return number of indexed primitives
+				 */
+				unsigned int getNbPrimitives() const
+				{
+					return m_primitives.size();
+				}
+
+				/**
+				 *  \brief Distance to the union of the primitives
+				 *
+				 *  \param pt query point
+				 *
+				 *  \return distance to the nearest primitive, -1 if there is no primitive
+				 */
+				double distance(const Eigen::Vector2d &pt) const
+				{
+					if(m_nodes.size() == 0)
+						return -1.0;
+
+					double distmin = -1.0;
+					unsigned int stack[StackSize];
+					unsigned int stacksize = 1;
+					stack[0] = 0;
+					while(stacksize != 0 && distmin != 0.0)
+					{
+						const Node &node = m_nodes[stack[--stacksize]];
+
+						// the distance to a primitive is at least the distance to its box
+						if(distmin != -1.0 && BoxDist(pt,node.ptmin,node.ptmax) >= distmin)
+							continue;
+
+						if(node.nbprimitives != 0)
+						{
+							for(unsigned int i = node.first; i < node.first + node.nbprimitives; i++)
+							{
+								double distcur = m_primitives[i].distance(pt);
+								if(distcur < distmin || distmin == -1.0)
+									distmin = distcur;
+							}
+						}
+						else
+						{
+							// nearest child visited first
+							unsigned int child1 = node.first, child2 = node.first + 1;
+							if(BoxDist(pt,m_nodes[child1].ptmin,m_nodes[child1].ptmax) < BoxDist(pt,m_nodes[child2].ptmin,m_nodes[child2].ptmax))
+								std::swap(child1,child2);
+							stack[stacksize++] = child1;
+							stack[stacksize++] = child2;
+						}
+					}
+
+					return distmin;
+				}
+		};
+	}
+}
+
+#endif //_BVH_H_
@@ -0,0 +1,210 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file BoundaryGrid.cpp
+ *  \brief Uniform grid over boundary vertices, for nearest vertex queries
+ *  \author Bastien Durix
+ */
+
+#include "BoundaryGrid.h"
+#include "DistanceKernels.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+algorithm::evaluation::BoundaryGrid::BoundaryGrid(const std::vector<Eigen::Vector2d> &vert) :
+	m_x(0), m_y(0), m_index(0), m_cell(0), m_origin(0.0,0.0), m_ptmax(0.0,0.0), m_cellsize(1.0), m_nbcol(1), m_nbrow(1)
+{
+	build(vert);
+}
+
+algorithm::evaluation::BoundaryGrid::BoundaryGrid(const boundary::DiscreteBoundary<2>::Ptr bnd) :
+	m_x(0), m_y(0), m_index(0), m_cell(0), m_origin(0.0,0.0), m_ptmax(0.0,0.0), m_cellsize(1.0), m_nbcol(1), m_nbrow(1)
+{
+	std::vector<Eigen::Vector2d> vert(0);
+	vert.reserve(bnd->getNbVertices());
+	bnd->getVerticesVector(vert);
+	build(vert);
+}
+
+void algorithm::evaluation::BoundaryGrid::build(const std::vector<Eigen::Vector2d> &vert)
+{
+	if(vert.size() == 0)
+	{
+		m_cell.assign(2,0);
+		return;
+	}
+
+	Eigen::Vector2d ptmin = vert[0], ptmax = vert[0];
+	for(unsigned int i = 1; i < vert.size(); i++)
+	{
+		ptmin = ptmin.cwiseMin(vert[i]);
+		ptmax = ptmax.cwiseMax(vert[i]);
+	}
+	
+	// about one cell per vertex, on the bounding box of the vertices
+	double width  = std::max(ptmax.x() - ptmin.x(), 1.0);
+	double height = std::max(ptmax.y() - ptmin.y(), 1.0);
+	m_cellsize = std::sqrt(width * height / (double)vert.size());
+	m_cellsize = std::max(m_cellsize, std::max(width,height) / (double)vert.size());
+	m_origin = ptmin;
+	m_ptmax = ptmax;
+	m_nbcol = (unsigned int)(width / m_cellsize) + 1;
+	m_nbrow = (unsigned int)(height / m_cellsize) + 1;
+
+	// counting sort of the vertices by cell
+	std::vector<unsigned int> vecind(vert.size());
+	m_cell.assign(m_nbcol * m_nbrow + 1, 0);
+	for(unsigned int i = 0; i < vert.size(); i++)
+	{
+		unsigned int c = std::min((unsigned int)((vert[i].x() - m_origin.x()) / m_cellsize), m_nbcol-1);
+		unsigned int l = std::min((unsigned int)((vert[i].y() - m_origin.y()) / m_cellsize), m_nbrow-1);
+		vecind[i] = c + m_nbcol * l;
+		m_cell[vecind[i]+1]++;
+	}
+	for(unsigned int i = 0; i < m_nbcol * m_nbrow; i++)
+		m_cell[i+1] += m_cell[i];
+
+	std::vector<unsigned int> vecpos(m_cell.begin(), m_cell.end()-1);
+	m_x.resize(vert.size());
+	m_y.resize(vert.size());
+	m_index.resize(vert.size());
+	for(unsigned int i = 0; i < vert.size(); i++)
+	{
+		unsigned int pos = vecpos[vecind[i]]++;
+		m_x[pos] = vert[i].x();
+		m_y[pos] = vert[i].y();
+		m_index[pos] = i;
+	}
+}
+
+unsigned int algorithm::evaluation::BoundaryGrid::getNbVertices() const
+{
+	return m_x.size();
+}
+
+Eigen::Vector2d algorithm::evaluation::BoundaryGrid::getCoordinates(unsigned int ind) const
+{
+	return Eigen::Vector2d(m_x[ind],m_y[ind]);
+}
+
+unsigned int algorithm::evaluation::BoundaryGrid::getIndex(unsigned int ind) const
+{
+	return m_index[ind];
+}
+
+const Eigen::Vector2d& algorithm::evaluation::BoundaryGrid::getLowerCorner() const
+{
+	return m_origin;
+}
+
+const Eigen::Vector2d& algorithm::evaluation::BoundaryGrid::getUpperCorner() const
+{
+	return m_ptmax;
+}
+
+double algorithm::evaluation::BoundaryGrid::nearestSqDist(const Eigen::Vector2d &pt, unsigned int &index) const
+{
+	index = 0;
+	if(m_x.size() == 0)
+		return 0.0;
+
+	double colf = std::floor((pt.x() - m_origin.x()) / m_cellsize);
+	double rowf = std::floor((pt.y() - m_origin.y()) / m_cellsize);
+	int col = (int)std::min(std::max(colf, 0.0), (double)(m_nbcol-1));
+	int row = (int)std::min(std::max(rowf, 0.0), (double)(m_nbrow-1));
+
+	// margin on the pruning bound, protecting against rounding errors
+	double margin = 1e-9 * m_cellsize;
+
+	double distmin = std::numeric_limits<double>::infinity();
+	for(int r = 0; ; r++)
+	{
+		int c0 = col - r, c1 = col + r;
+		int l0 = row - r, l1 = row + r;
+		
+		// visit the cells of the ring
+		for(int l = std::max(l0,0); l <= std::min(l1,(int)m_nbrow-1); l++)
+		{
+			int step = (l == l0 || l == l1) ? 1 : c1 - c0;
+			for(int c = c0; c <= c1; c += step)
+			{
+				if(c < 0 || c >= (int)m_nbcol) continue;
+				
+				unsigned int cell = c + m_nbcol * l;
+				if(m_cell[cell] == m_cell[cell+1]) continue;
+
+				// vertices of a cell keep their original order, the kernel gives the lowest index on ties
+				boundary::DiscreteBoundary<2>::VerticesView view{&m_x[m_cell[cell]],&m_y[m_cell[cell]],m_cell[cell+1] - m_cell[cell]};
+				unsigned int k;
+				double dist = NearestSqDist(pt,view,k);
+				k += m_cell[cell];
+				if(dist < distmin || (dist == distmin && m_index[k] < index))
+				{
+					distmin = dist;
+					index = m_index[k];
+				}
+			}
+		}
+
+		// lower bound of the distance to the cells out of the ring
+		bool remaining = false;
+		double bound = std::numeric_limits<double>::infinity();
+		if(c0 > 0)
+		{
+			remaining = true;
+			bound = std::min(bound, pt.x() - (m_origin.x() + c0 * m_cellsize));
+		}
+		if(c1 < (int)m_nbcol-1)
+		{
+			remaining = true;
+			bound = std::min(bound, m_origin.x() + (c1+1) * m_cellsize - pt.x());
+		}
+		if(l0 > 0)
+		{
+			remaining = true;
+			bound = std::min(bound, pt.y() - (m_origin.y() + l0 * m_cellsize));
+		}
+		if(l1 < (int)m_nbrow-1)
+		{
+			remaining = true;
+			bound = std::min(bound, m_origin.y() + (l1+1) * m_cellsize - pt.y());
+		}
+
+		if(!remaining)
+			break;
+
+		bound -= margin;
+		if(bound > 0.0 && bound * bound > distmin)
+			break;
+	}
+
+	return distmin;
+}
+
+double algorithm::evaluation::BoundaryGrid::nearestSqDist(const Eigen::Vector2d &pt) const
+{
+	unsigned int index;
+	return nearestSqDist(pt,index);
+}
@@ -0,0 +1,192 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file BoundaryGrid.h
+ *  \brief Uniform grid over boundary vertices, for nearest vertex queries
+ *  \author Bastien Durix
+ */
+
+#ifndef _BOUNDARYGRID_H_
+#define _BOUNDARYGRID_H_
+
+#include <memory>
+#include <vector>
+#include <Eigen/Dense>
+#include <boundary/DiscreteBoundary2.h>
+
+/**
+ *  \brief Lots of algorithms
+ */
+namespace algorithm
+{
+	/**
+	 *  \brief Evaluation algorithms
+	 */
+	namespace evaluation
+	{
+		/**
+		 *  \brief Uniform grid indexing a set of 2d vertices
+		 *
+		 *  \details Vertices are bucketed once in square cells, stored contiguously cell by cell.
+		 *           Nearest vertex queries visit rings of cells around the query point, and stop
+		 *           as soon as the remaining cells cannot contain a closer vertex.
+		 */
+		class BoundaryGrid
+		{
+			public:
+				/**
+				 *  \brief Grid shared pointer
+				 */
+				using Ptr = std::shared_ptr<BoundaryGrid>;
+
+			protected:
+				/**
+				 *  \brief Abscissas of the vertices, sorted cell by cell
+				 */
+				std::vector<double> m_x;
+
+				/**
+				 *  \brief Ordinates of the vertices, sorted cell by cell
+				 */
+				std::vector<double> m_y;
+
+				/**
+				 *  \brief Original index of each sorted vertex
+				 */
+				std::vector<unsigned int> m_index;
+
+				/**
+				 *  \brief First sorted vertex of each cell (one more element than cells)
+				 */
+				std::vector<unsigned int> m_cell;
+
+				/**
+				 *  \brief Lower corner of the grid
+				 */
+				Eigen::Vector2d m_origin;
+
+				/**
+				 *  \brief Upper corner of the bounding box of the vertices
+				 */
+				Eigen::Vector2d m_ptmax;
+
+				/**
+				 *  \brief Size of a cell
+				 */
+				double m_cellsize;
+
+				/**
+				 *  \brief Number of columns
+				 */
+				unsigned int m_nbcol;
+
+				/**
+				 *  \brief Number of rows
+				 */
+				unsigned int m_nbrow;
+
+				/**
+				 *  \brief Buckets the vertices in the grid
+				 *
+				 *  \param vert vertices to index
+				 */
+				void build(const std::vector<Eigen::Vector2d> &vert);
+
+			public:
+				/**
+				 *  \brief Constructor
+				 *
+				 *  \param vert vertices to index
+				 */
+				BoundaryGrid(const std::vector<Eigen::Vector2d> &vert);
+
+				/**
+				 *  \brief Constructor
+				 *
+				 *  \param bnd boundary whose vertices are indexed
+				 */
+				BoundaryGrid(const boundary::DiscreteBoundary<2>::Ptr bnd);
+
+				/**
+				 *  \brief Number of vertices getter
+				 *
+				 *  \return number of indexed vertices
+				 */
+				unsigned int getNbVertices() const;
+
+				/**
+				 *  \brief Sorted vertex getter
+				 *
+				 *  \param ind index of the vertex in the grid order
+				 *
+				 *  \return coordinates of the vertex
+				 */
+				Eigen::Vector2d getCoordinates(unsigned int ind) const;
+
+				/**
+				 *  \brief Original index getter
+				 *
+				 *  \param ind index of the vertex in the grid order
+				 *
+				 *  \return index of the vertex in the indexed container
+				 */
+				unsigned int getIndex(unsigned int ind) const;
+
+				/**
+				 *  \brief Lower corner getter
+				 *
+				 *  \return lower corner of the bounding box of the vertices
+				 */
+				const Eigen::Vector2d& getLowerCorner() const;
+
+				/**
+				 *  \brief Upper corner getter
+				 *
+				 *  \return upper corner of the bounding box of the vertices
+				 */
+				const Eigen::Vector2d& getUpperCorner() const;
+
+				/**
+				 *  \brief Squared distance to the nearest vertex
+				 *
+				 *  \param pt    query point
+				 *  \param index original index of the nearest vertex (lowest one in case of ties)
+				 *
+				 *  \return squared distance to the nearest vertex, 0 if the grid is empty
+				 */
+				double nearestSqDist(const Eigen::Vector2d &pt, unsigned int &index) const;
+
+				/**
+				 *  \brief Squared distance to the nearest vertex
+				 *
+				 *  \param pt query point
+				 *
+				 *  \return squared distance to the nearest vertex, 0 if the grid is empty
+				 */
+				double nearestSqDist(const Eigen::Vector2d &pt) const;
+		};
+	}
+}
+
+#endif //_BOUNDARYGRID_H_
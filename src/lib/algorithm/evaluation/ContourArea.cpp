@@ -0,0 +1,124 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file ContourArea.cpp
+ *  \brief Areas of shapes, computed from their boundary
+ *  \author Bastien Durix
+ */
+
+#include "ContourArea.h"
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+double algorithm::evaluation::ContourArea(const boundary::DiscreteBoundary<2>::Ptr bnd, unsigned int loop)
+{
+	boundary::DiscreteBoundary<2>::VerticesView vert = bnd->getView();
+	unsigned int beg = bnd->getLoopBegin(loop), end = bnd->getLoopEnd(loop);
+
+	// shoelace formula, with ordinates going down
+	double area = vert.x[end-1] * vert.y[beg] - vert.x[beg] * vert.y[end-1];
+	for(unsigned int i = beg; i+1 < end; i++)
+		area += vert.x[i] * vert.y[i+1] - vert.x[i+1] * vert.y[i];
+	
+	return 0.5 * area;
+}
+
+double algorithm::evaluation::ContourArea(const boundary::DiscreteBoundary<2>::Ptr bnd)
+{
+	double area = 0.0;
+#pragma omp parallel for reduction(+:area)
+	for(unsigned int k = 0; k < bnd->getNbLoops(); k++)
+		area += ContourArea(bnd,k);
+	return area;
+}
+
+std::vector<double> algorithm::evaluation::RegionAreas(const boundary::DiscreteBoundary<2>::Ptr bnd, const std::vector<int> &parent)
+{
+	if(parent.size() != bnd->getNbLoops())
+		throw std::logic_error("algorithm::evaluation::RegionAreas : one parent per loop is needed");
+
+	std::vector<double> loopareas(bnd->getNbLoops());
+#pragma omp parallel for schedule(dynamic)
+	for(unsigned int k = 0; k < loopareas.size(); k++)
+		loopareas[k] = ContourArea(bnd,k);
+
+	// children loops carve their region out of their parent's one
+	std::vector<double> areas(loopareas);
+	for(unsigned int k = 0; k < parent.size(); k++)
+		if(parent[k] != -1)
+			areas[parent[k]] += loopareas[k];
+
+	return areas;
+}
+
+/**
+ *  \brief Intervals boundaries of the lines of pixels of a shape
+ *
+ *  \param bnd    boundary of the shape, made of pixel borders
+ *  \param shape  index of the shape, given to the events
+ *  \param events line, column, shape and side (1 entering the shape, -1 leaving it) of the vertical borders
+ */
+static void IntervalEvents(const boundary::DiscreteBoundary<2>::Ptr bnd, int shape, std::vector<std::tuple<double,double,int,int> > &events)
+{
+	boundary::DiscreteBoundary<2>::VerticesView vert = bnd->getView();
+	for(unsigned int i = 0; i < vert.size; i++)
+	{
+		unsigned int next = bnd->getNext(i);
+		double dx = vert.x[next] - vert.x[i], dy = vert.y[next] - vert.y[i];
+		if(dx == 0.0 && (dy == 1.0 || dy == -1.0))
+			// the shape is on the right of the borders: going up enters it
+			events.push_back(std::make_tuple(std::min(vert.y[i],vert.y[next]),vert.x[i],shape,dy < 0.0 ? 1 : -1));
+		else if(dy != 0.0 || (dx != 1.0 && dx != -1.0))
+			throw std::logic_error("algorithm::evaluation::IoU : boundary is not made of pixel borders");
+	}
+}
+
+double algorithm::evaluation::IoU(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2)
+{
+	std::vector<std::tuple<double,double,int,int> > events(0);
+	events.reserve(bnd1->getNbVertices()/2 + bnd2->getNbVertices()/2);
+	IntervalEvents(bnd1,0,events);
+	IntervalEvents(bnd2,1,events);
+	std::sort(events.begin(),events.end());
+
+	double area1 = 0.0, area2 = 0.0, areainter = 0.0;
+	int in[2] = {0,0};
+	for(unsigned int i = 0; i < events.size(); i++)
+	{
+		if(i != 0 && std::get<0>(events[i]) == std::get<0>(events[i-1]))
+		{
+			double length = std::get<1>(events[i]) - std::get<1>(events[i-1]);
+			if(in[0]) area1 += length;
+			if(in[1]) area2 += length;
+			if(in[0] && in[1]) areainter += length;
+		}
+		in[std::get<2>(events[i])] += std::get<3>(events[i]);
+	}
+
+	double areaunion = area1 + area2 - areainter;
+	if(areaunion == 0.0)
+		return 1.0;
+	return areainter / areaunion;
+}
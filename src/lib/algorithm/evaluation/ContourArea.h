@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file ContourArea.h
+ *  \brief Areas of shapes, computed from their boundary
+ *  \author Bastien Durix
+ */
+
+#ifndef _CONTOURAREA_H_
+#define _CONTOURAREA_H_
+
+#include <vector>
+#include <boundary/DiscreteBoundary2.h>
+
+/**
+ *  \brief Lots of algorithms
+ */
+namespace algorithm
+{
+	/**
+	 *  \brief Evaluation algorithms
+	 */
+	namespace evaluation
+	{
+		/**
+		 *  \brief Computes the signed area enclosed by a loop of a boundary
+		 *
+		 *  \param bnd  boundary
+		 *  \param loop index of the loop
+		 *
+		 *  \return area enclosed by the loop, positive for outer borders and negative for holes
+		 */
+		double ContourArea(const boundary::DiscreteBoundary<2>::Ptr bnd, unsigned int loop);
+
+		/**
+		 *  \brief Computes the area of a shape from its boundary
+		 *
+		 *  \param bnd boundary of the shape
+		 *
+		 *  \return area of the shape
+		 */
+		double ContourArea(const boundary::DiscreteBoundary<2>::Ptr bnd);
+
+		/**
+		 *  \brief Computes the area of the region bounded by each loop and its children
+		 *
+		 *  \details Regions bounded by outer borders are shape components, with a positive area. Regions
+		 *           bounded by holes have a negative area. Loops are processed in parallel.
+		 *
+		 *  \param bnd    boundary
+		 *  \param parent index of the loop directly enclosing each loop, -1 for outermost loops
+		 *
+		 *  \return signed area of the region of each loop
+		 */
+		std::vector<double> RegionAreas(const boundary::DiscreteBoundary<2>::Ptr bnd, const std::vector<int> &parent);
+
+		/**
+		 *  \brief Computes the intersection over union of two shapes, from their pixel borders
+		 *
+		 *  \details Vertical borders of each line of pixels are sorted into intervals, which are intersected.
+		 *           Boundaries have to be made of pixel borders, as given by BorderFollowing.
+		 *
+		 *  \param bnd1 boundary of the first shape
+		 *  \param bnd2 boundary of the second shape
+		 *
+		 *  \return intersection area divided by union area (1 if both shapes are empty)
+		 */
+		double IoU(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2);
+	}
+}
+
+#endif //_CONTOURAREA_H_
@@ -0,0 +1,87 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file DiskBVH.cpp
+ *  \brief Bounding volume hierarchy over the disks of a skeleton
+ *  \author Bastien Durix
+ */
+
+#include "DiskBVH.h"
+#include <list>
+#include <stdexcept>
+#include <mathtools/geometry/euclidian/HyperSphere.h>
+
+Eigen::Vector2d algorithm::evaluation::Disk::getMin() const
+{
+	return center - Eigen::Vector2d::Constant(radius);
+}
+
+Eigen::Vector2d algorithm::evaluation::Disk::getMax() const
+{
+	return center + Eigen::Vector2d::Constant(radius);
+}
+
+double algorithm::evaluation::Disk::distance(const Eigen::Vector2d &pt) const
+{
+	double distpt = (pt - center).norm();
+	
+	double distcur = 0.0;
+
+	if(distpt > radius)
+		distcur = distpt - radius;
+
+	return distcur;
+}
+
+algorithm::evaluation::DiskBVH::DiskBVH(const std::vector<Eigen::Vector2d> &center, const std::vector<double> &radius)
+{
+	if(center.size() != radius.size())
+		throw std::logic_error("algorithm::evaluation::DiskBVH : one radius per center is needed");
+
+	m_primitives.resize(center.size());
+	for(unsigned int i = 0; i < center.size(); i++)
+		m_primitives[i] = Disk{center[i],radius[i]};
+
+	build();
+}
+
+algorithm::evaluation::DiskBVH::DiskBVH(const skeleton::GraphSkel2d::Ptr grskl, const mathtools::affine::Frame<2>::Ptr frame)
+{
+	std::list<unsigned int> lnod;
+	std::list<mathtools::geometry::euclidian::HyperSphere<2> > lnodcir;
+	grskl->getAllNodes(lnod);
+	grskl->getNodes<mathtools::geometry::euclidian::HyperSphere<2>,std::list<unsigned int>,std::list<mathtools::geometry::euclidian::HyperSphere<2> > >(lnod,lnodcir);
+
+	// centers are expressed once in the query frame
+	m_primitives.reserve(lnodcir.size());
+	for(std::list<mathtools::geometry::euclidian::HyperSphere<2> >::iterator it = lnodcir.begin(); it != lnodcir.end(); it++)
+		m_primitives.push_back(Disk{it->getCenter().getCoords(frame),it->getRadius()});
+
+	build();
+}
+
+unsigned int algorithm::evaluation::DiskBVH::getNbDisks() const
+{
+	return getNbPrimitives();
+}
@@ -0,0 +1,126 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file DiskBVH.h
+ *  \brief Bounding volume hierarchy over the disks of a skeleton
+ *  \author Bastien Durix
+ */
+
+#ifndef _DISKBVH_H_
+#define _DISKBVH_H_
+
+#include <memory>
+#include <vector>
+#include <Eigen/Dense>
+#include <skeleton/Skeletons.h>
+#include <mathtools/affine/Frame.h>
+#include "BVH.h"
+
+/**
+ *  \brief Lots of algorithms
+ */
+namespace algorithm
+{
+	/**
+	 *  \brief Evaluation algorithms
+	 */
+	namespace evaluation
+	{
+		/**
+		 *  \brief Disk indexed in a hierarchy
+		 */
+		struct Disk
+		{
+			/**
+			 *  \brief Center
+			 */
+			Eigen::Vector2d center;
+
+			/**
+			 *  \brief Radius
+			 */
+			double radius;
+
+			/**
+			 *  \brief Lower corner of the bounding box
+			 *
+			 *  \return lower corner
+			 */
+			Eigen::Vector2d getMin() const;
+
+			/**
+			 *  \brief Upper corner of the bounding box
+			 *
+			 *  \return upper corner
+			 */
+			Eigen::Vector2d getMax() const;
+
+			/**
+			 *  \brief Distance to a point
+			 *
+			 *  \param pt point
+			 *
+			 *  \return distance to the disk (0 inside)
+			 */
+			double distance(const Eigen::Vector2d &pt) const;
+		};
+
+		/**
+		 *  \brief Bounding volume hierarchy over a set of disks
+		 */
+		class DiskBVH : public BVH<Disk>
+		{
+			public:
+				/**
+				 *  \brief Hierarchy shared pointer
+				 */
+				using Ptr = std::shared_ptr<DiskBVH>;
+
+				/**
+				 *  \brief Constructor
+				 *
+				 *  \param center disks centers
+				 *  \param radius disks radii
+				 */
+				DiskBVH(const std::vector<Eigen::Vector2d> &center, const std::vector<double> &radius);
+
+				/**
+				 *  \brief Constructor, from the nodes of a skeleton
+				 *
+				 *  \param grskl skeleton whose nodes are indexed
+				 *  \param frame frame in which the centers are expressed
+				 */
+				DiskBVH(const skeleton::GraphSkel2d::Ptr grskl, const mathtools::affine::Frame<2>::Ptr frame);
+
+				/**
+				 *  \brief Number of disks getter
+				 *
+				 *  \return number of indexed disks
+				 */
+				unsigned int getNbDisks() const;
+		};
+	}
+}
+
+#endif //_DISKBVH_H_
@@ -0,0 +1,121 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file DistanceKernels.cpp
+ *  \brief Nearest vertex distance kernels on contiguous coordinates
+ *  \author Bastien Durix
+ */
+
+#include "DistanceKernels.h"
+#include <limits>
+#include <algorithm>
+
+/**
+ *  \brief Number of vertices processed at once by the kernels
+ */
+static const unsigned int blocksize = 64;
+
+/**
+ *  \brief Minimal squared distance from a point to a block of vertices
+ *
+ *  \param px  point abscissa
+ *  \param py  point ordinate
+ *  \param x   abscissas of the vertices
+ *  \param y   ordinates of the vertices
+ *  \param beg first vertex of the block
+ *  \param end vertex after the block
+ *
+ *  \return minimal squared distance
+ */
+static inline double BlockSqDist(double px, double py, const double *x, const double *y, unsigned int beg, unsigned int end)
+{
+	double distmin = std::numeric_limits<double>::infinity();
+#pragma omp simd reduction(min:distmin)
+	for(unsigned int i = beg; i < end; i++)
+	{
+		double dx = x[i] - px;
+		double dy = y[i] - py;
+		double dist = dx * dx + dy * dy;
+		distmin = dist < distmin ? dist : distmin;
+	}
+	return distmin;
+}
+
+double algorithm::evaluation::NearestSqDist(const Eigen::Vector2d &pt, const boundary::DiscreteBoundary<2>::VerticesView &vert)
+{
+	return BlockSqDist(pt.x(),pt.y(),vert.x,vert.y,0,vert.size);
+}
+
+double algorithm::evaluation::NearestSqDist(const Eigen::Vector2d &pt, const boundary::DiscreteBoundary<2>::VerticesView &vert, unsigned int &index)
+{
+	index = 0;
+	double distmin = std::numeric_limits<double>::infinity();
+	for(unsigned int beg = 0; beg < vert.size; beg += blocksize)
+	{
+		unsigned int end = std::min(beg + blocksize, vert.size);
+		if(BlockSqDist(pt.x(),pt.y(),vert.x,vert.y,beg,end) < distmin)
+		{
+			// the block contains a closer vertex
+			for(unsigned int i = beg; i < end; i++)
+			{
+				double dist = (Eigen::Vector2d(vert.x[i],vert.y[i]) - pt).squaredNorm();
+				if(dist < distmin)
+				{
+					distmin = dist;
+					index = i;
+				}
+			}
+		}
+	}
+	return distmin;
+}
+
+double algorithm::evaluation::NearestSqDistAbove(const Eigen::Vector2d &pt, const boundary::DiscreteBoundary<2>::VerticesView &vert, double bound)
+{
+	double distmin = std::numeric_limits<double>::infinity();
+	for(unsigned int beg = 0; beg < vert.size; beg += blocksize)
+	{
+		double dist = BlockSqDist(pt.x(),pt.y(),vert.x,vert.y,beg,std::min(beg + blocksize, vert.size));
+		if(dist < distmin)
+		{
+			distmin = dist;
+			if(distmin <= bound)
+				break;
+		}
+	}
+	return distmin;
+}
+
+double algorithm::evaluation::DirectedSqHausDist(const boundary::DiscreteBoundary<2>::VerticesView &vert1, const boundary::DiscreteBoundary<2>::VerticesView &vert2)
+{
+	double distmax = 0.0;
+#pragma omp parallel for reduction(max:distmax)
+	for(unsigned int i = 0; i < vert1.size; i++)
+	{
+		double dist = BlockSqDist(vert1.x[i],vert1.y[i],vert2.x,vert2.y,0,vert2.size);
+		if(dist > distmax)
+			distmax = dist;
+	}
+	return distmax;
+}
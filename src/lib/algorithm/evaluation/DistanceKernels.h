@@ -0,0 +1,90 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file DistanceKernels.h
+ *  \brief Nearest vertex distance kernels on contiguous coordinates
+ *  \author Bastien Durix
+ */
+
+#ifndef _DISTANCEKERNELS_H_
+#define _DISTANCEKERNELS_H_
+
+#include <Eigen/Dense>
+#include <boundary/DiscreteBoundary2.h>
+
+/**
+ *  \brief Lots of algorithms
+ */
+namespace algorithm
+{
+	/**
+	 *  \brief Evaluation algorithms
+	 */
+	namespace evaluation
+	{
+		/**
+		 *  \brief Squared distance from a point to the nearest vertex of a set
+		 *
+		 *  \param pt   point
+		 *  \param vert coordinates of the vertices
+		 *
+		 *  \return minimal squared distance (infinity if there is no vertex)
+		 */
+		double NearestSqDist(const Eigen::Vector2d &pt, const boundary::DiscreteBoundary<2>::VerticesView &vert);
+
+		/**
+		 *  \brief Squared distance from a point to the nearest vertex of a set
+		 *
+		 *  \param pt    point
+		 *  \param vert  coordinates of the vertices
+		 *  \param index index of the nearest vertex (the lowest one in case of tie)
+		 *
+		 *  \return minimal squared distance (infinity if there is no vertex)
+		 */
+		double NearestSqDist(const Eigen::Vector2d &pt, const boundary::DiscreteBoundary<2>::VerticesView &vert, unsigned int &index);
+
+		/**
+		 *  \brief Squared distance from a point to the nearest vertex of a set, stopping below a bound
+		 *
+		 *  \param pt    point
+		 *  \param vert  coordinates of the vertices
+		 *  \param bound squared distance under which the search stops
+		 *
+		 *  \return minimal squared distance, or a squared distance lower than bound
+		 */
+		double NearestSqDistAbove(const Eigen::Vector2d &pt, const boundary::DiscreteBoundary<2>::VerticesView &vert, double bound);
+
+		/**
+		 *  \brief Directed squared Hausdorff distance between two sets of vertices
+		 *
+		 *  \param vert1 coordinates of the vertices from which the distance is computed
+		 *  \param vert2 coordinates of the vertices to which the distance is computed
+		 *
+		 *  \return maximal squared distance of the first vertices to the second ones
+		 */
+		double DirectedSqHausDist(const boundary::DiscreteBoundary<2>::VerticesView &vert1, const boundary::DiscreteBoundary<2>::VerticesView &vert2);
+	}
+}
+
+#endif //_DISTANCEKERNELS_H_
@@ -0,0 +1,183 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file DistanceMap.cpp
+ *  \brief Euclidean distance transform of the boundary of a discrete shape
+ *  \author Bastien Durix
+ */
+
+#include "DistanceMap.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+void algorithm::evaluation::BoundaryPixels(const shape::DiscreteShape<2>::Ptr dissh, std::vector<std::size_t> &pixels)
+{
+	const shape::DiscreteShape<2> &shp = *dissh;
+	const unsigned char *disc = shp.getData();
+	const std::size_t stride = shp.getStride();
+	unsigned int width = shp.getWidth();
+	unsigned int height = shp.getHeight();
+
+	for(unsigned int l = 0; l < height; l++)
+	{
+		for(unsigned int c = 0; c < width; c++)
+		{
+			std::size_t pos = c + stride * l;
+			if(disc[pos])
+			{
+				if(c == 0 || c == width-1 || l == 0 || l == height-1 ||
+				   !disc[pos-1] || !disc[pos+1] || !disc[pos-stride] || !disc[pos+stride])
+					pixels.push_back(c + (std::size_t)width * l);
+			}
+		}
+	}
+}
+
+algorithm::evaluation::DistanceMap::DistanceMap(const shape::DiscreteShape<2>::Ptr dissh) :
+	m_dist((std::size_t)dissh->getWidth()*dissh->getHeight(),std::numeric_limits<unsigned long long>::max()), m_boundary(0), m_width(dissh->getWidth()), m_height(dissh->getHeight())
+{
+	BoundaryPixels(dissh,m_boundary);
+	transform();
+}
+
+algorithm::evaluation::DistanceMap::DistanceMap(unsigned int width, unsigned int height, const std::vector<std::size_t> &boundary) :
+	m_dist((std::size_t)width*height,std::numeric_limits<unsigned long long>::max()), m_boundary(boundary), m_width(width), m_height(height)
+{
+	transform();
+}
+
+void algorithm::evaluation::DistanceMap::transform()
+{
+	const unsigned long long inf = std::numeric_limits<unsigned long long>::max();
+
+	if(m_boundary.size() == 0)
+		return;
+	
+	//first step: distance to the nearest boundary pixel in the same column
+	for(std::size_t i = 0; i < m_boundary.size(); i++)
+		m_dist[m_boundary[i]] = 0;
+	
+	for(unsigned int l = 1; l < m_height; l++)
+	{
+		unsigned long long *row = &m_dist[(std::size_t)m_width * l];
+		const unsigned long long *rowprev = row - m_width;
+		for(unsigned int c = 0; c < m_width; c++)
+			if(row[c] != 0 && rowprev[c] != inf)
+				row[c] = rowprev[c] + 1;
+	}
+
+	for(unsigned int l = m_height-1; l > 0; l--)
+	{
+		unsigned long long *row = &m_dist[(std::size_t)m_width * (l-1)];
+		const unsigned long long *rownext = row + m_width;
+		for(unsigned int c = 0; c < m_width; c++)
+			if(rownext[c] != inf && rownext[c] + 1 < row[c])
+				row[c] = rownext[c] + 1;
+	}
+
+	//second step: lower envelope of the parabolas rooted at each column distance, row by row
+#pragma omp parallel
+	{
+		std::vector<double> vecf(m_width);
+		std::vector<unsigned int> vecv(m_width);
+		std::vector<double> vecz(m_width+1);
+
+#pragma omp for
+		for(unsigned int l = 0; l < m_height; l++)
+		{
+			unsigned long long *row = &m_dist[(std::size_t)m_width * l];
+			
+			int k = -1;
+			for(unsigned int q = 0; q < m_width; q++)
+			{
+				if(row[q] == inf) continue;
+				
+				double fq = (double)row[q] * (double)row[q];
+				double s = -std::numeric_limits<double>::infinity();
+				while(k >= 0)
+				{
+					double p = (double)vecv[k];
+					s = ((fq + (double)q*(double)q) - (vecf[k] + p*p)) / (2.0*(double)q - 2.0*p);
+					if(s <= vecz[k])
+						k--;
+					else
+						break;
+				}
+				if(k < 0)
+					s = -std::numeric_limits<double>::infinity();
+				k++;
+				vecv[k] = q;
+				vecf[k] = fq;
+				vecz[k] = s;
+			}
+
+			if(k < 0) continue;
+			
+			vecz[k+1] = std::numeric_limits<double>::infinity();
+			int j = 0;
+			for(unsigned int q = 0; q < m_width; q++)
+			{
+				while(vecz[j+1] < (double)q)
+					j++;
+				double d = (double)q - (double)vecv[j];
+				row[q] = (unsigned long long)(d*d + vecf[j]);
+			}
+		}
+	}
+}
+
+unsigned int algorithm::evaluation::DistanceMap::getWidth() const
+{
+	return m_width;
+}
+
+unsigned int algorithm::evaluation::DistanceMap::getHeight() const
+{
+	return m_height;
+}
+
+const std::vector<std::size_t>& algorithm::evaluation::DistanceMap::getBoundary() const
+{
+	return m_boundary;
+}
+
+const std::vector<unsigned long long>& algorithm::evaluation::DistanceMap::getContainer() const
+{
+	return m_dist;
+}
+
+unsigned long long algorithm::evaluation::DistanceMap::getSqDist(std::size_t ind) const
+{
+	if(ind >= m_dist.size()) throw std::logic_error("algorithm::evaluation::DistanceMap::getSqDist : index out of bounds");
+	return m_dist[ind];
+}
+
+double algorithm::evaluation::DistanceMap::getDist(std::size_t ind) const
+{
+	unsigned long long sqdist = getSqDist(ind);
+	if(sqdist == std::numeric_limits<unsigned long long>::max())
+		return std::numeric_limits<double>::infinity();
+	return std::sqrt((double)sqdist);
+}
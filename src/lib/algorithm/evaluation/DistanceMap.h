@@ -0,0 +1,165 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file DistanceMap.h
+ *  \brief Euclidean distance transform of the boundary of a discrete shape
+ *  \author Bastien Durix
+ */
+
+#ifndef _DISTANCEMAP_H_
+#define _DISTANCEMAP_H_
+
+#include <memory>
+#include <vector>
+#include <shape/DiscreteShape.h>
+
+/**
+ *  \brief Lots of algorithms
+ */
+namespace algorithm
+{
+	/**
+	 *  \brief Evaluation algorithms
+	 */
+	namespace evaluation
+	{
+		/**
+		 *  \brief Extracts the boundary pixels of a discrete shape
+		 *
+		 *  \details A boundary pixel is a pixel of the shape with at least one
+		 *           4-neighbor out of the shape (or out of the image)
+		 *
+		 *  \param dissh  discrete shape
+		 *  \param pixels indices of the boundary pixels, row wise (c + width * l, which exceeds 32 bits on large shapes)
+		 */
+		void BoundaryPixels(const shape::DiscreteShape<2>::Ptr dissh, std::vector<std::size_t> &pixels);
+
+		/**
+		 *  \brief Exact squared Euclidean distance transform to the boundary pixels of a shape
+		 *
+		 *  \details Computed with the separable linear time algorithm of Felzenszwalb and Huttenlocher
+		 */
+		class DistanceMap
+		{
+			public:
+				/**
+				 *  \brief Distance map shared pointer
+				 */
+				using Ptr = std::shared_ptr<DistanceMap>;
+
+			protected:
+				/**
+				 *  \brief Squared distance of each pixel to the nearest boundary pixel, row wise
+				 *
+				 *  \details 64 bits, since squared distances exceed 32 bits beyond about 46000 pixels per side
+				 */
+				std::vector<unsigned long long> m_dist;
+
+				/**
+				 *  \brief Indices of the boundary pixels, row wise
+				 */
+				std::vector<std::size_t> m_boundary;
+
+				/**
+				 *  \brief Map width
+				 */
+				unsigned int m_width;
+
+				/**
+				 *  \brief Map height
+				 */
+				unsigned int m_height;
+
+				/**
+				 *  \brief Computes the distance transform of the boundary pixels
+				 */
+				void transform();
+
+			public:
+				/**
+				 *  \brief Constructor
+				 *
+				 *  \param dissh discrete shape whose boundary is transformed
+				 */
+				DistanceMap(const shape::DiscreteShape<2>::Ptr dissh);
+
+				/**
+				 *  \brief Constructor, from already extracted boundary pixels
+				 *
+				 *  \param width    width of the map
+				 *  \param height   height of the map
+				 *  \param boundary indices of the boundary pixels, row wise
+				 */
+				DistanceMap(unsigned int width, unsigned int height, const std::vector<std::size_t> &boundary);
+
+				/**
+				 *  \brief Width getter
+				 *
+				 *  \return width of the map
+				 */
+				unsigned int getWidth() const;
+
+				/**
+				 *  \brief Height getter
+				 *
+				 *  \return height of the map
+				 */
+				unsigned int getHeight() const;
+
+				/**
+				 *  \brief Boundary pixels getter
+				 *
+				 *  \return indices of the boundary pixels, row wise
+				 */
+				const std::vector<std::size_t>& getBoundary() const;
+
+				/**
+				 *  \brief Container getter
+				 *
+				 *  \return squared distances, row wise (ULLONG_MAX everywhere if the boundary is empty)
+				 */
+				const std::vector<unsigned long long>& getContainer() const;
+
+				/**
+				 *  \brief Squared distance getter
+				 *
+				 *  \param ind pixel index, row wise
+				 *
+				 *  \return squared distance to the nearest boundary pixel
+				 */
+				unsigned long long getSqDist(std::size_t ind) const;
+
+				/**
+				 *  \brief Distance getter
+				 *
+				 *  \param ind pixel index, row wise
+				 *
+				 *  \return distance to the nearest boundary pixel
+				 */
+				double getDist(std::size_t ind) const;
+		};
+	}
+}
+
+#endif //_DISTANCEMAP_H_
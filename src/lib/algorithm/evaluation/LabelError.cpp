@@ -0,0 +1,186 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file LabelError.cpp
+ *  \brief Computes the errors between the labels of two multi-label shapes
+ *  \author Bastien Durix
+ */
+
+#include "LabelError.h"
+#include "BoundaryGrid.h"
+#include "ShapeError.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+/**
+ *  \brief Number of corners lines gathered by each task
+ */
+static const unsigned int LabelChunkLines = 64;
+
+/**
+ *  \brief Areas and boundary vertices of all labels, on a chunk of lines of one shape
+ */
+struct LabelChunk
+{
+	/**
+	 *  \brief Area of each label
+	 */
+	std::vector<unsigned long long> area;
+
+	/**
+	 *  \brief Crack boundary vertices of each label
+	 */
+	std::vector<std::vector<Eigen::Vector2d> > vert;
+
+	/**
+	 *  \brief Default constructor
+	 */
+	LabelChunk() :
+		area(256,0), vert(256) {}
+};
+
+/**
+ *  \brief Finds the crack boundary vertices of all labels on a line of pixel corners
+ *
+ *  \details Corner (c,l) is a boundary vertex of each label around it, unless the four pixels around it have the same label
+ *
+ *  \param labels     labels of the shape, row wise
+ *  \param width      width of the shape
+ *  \param height     height of the shape
+ *  \param l          index of the corners line
+ *  \param background background label, without boundary
+ *  \param vert       vertices of each label, where the vertices are added
+ */
+static void CornerLine(const unsigned char *labels, unsigned int width, unsigned int height, unsigned int l, unsigned char background, std::vector<std::vector<Eigen::Vector2d> > &vert)
+{
+	// pixels outside of the image are background
+	const unsigned char *prev = l > 0 ? labels + (std::size_t)width * (l-1) : nullptr;
+	const unsigned char *cur = l < height ? labels + (std::size_t)width * l : nullptr;
+	unsigned char tl = background, bl = background;
+	for(unsigned int c = 0; c <= width; c++)
+	{
+		unsigned char tr = (prev && c < width) ? prev[c] : background;
+		unsigned char br = (cur && c < width) ? cur[c] : background;
+		if(!(tl == tr && tl == bl && tl == br))
+		{
+			Eigen::Vector2d pt((double)c,(double)l);
+			unsigned char around[4] = {tl,tr,bl,br};
+			for(unsigned int i = 0; i < 4; i++)
+			{
+				bool first = around[i] != background;
+				for(unsigned int j = 0; j < i && first; j++)
+					first = around[j] != around[i];
+				if(first)
+					vert[around[i]].push_back(pt);
+			}
+		}
+		tl = tr;
+		bl = br;
+	}
+}
+
+std::vector<algorithm::evaluation::LabelErrors> algorithm::evaluation::LabelError(const shape::LabelShape<2>::Ptr shpref, const shape::LabelShape<2>::Ptr shpcmp, const OptionsLabelError &options)
+{
+	if(shpref->getWidth() != shpcmp->getWidth() || shpref->getHeight() != shpcmp->getHeight())
+		throw std::logic_error("algorithm::evaluation::LabelError : shapes sizes differ");
+
+	const unsigned int width = shpref->getWidth();
+	const unsigned int height = shpref->getHeight();
+	const unsigned char *labref = shpref->getContainer().data();
+	const unsigned char *labcmp = shpcmp->getContainer().data();
+
+	// single pass over both shapes, on chunks of corners lines (line l closes row l-1)
+	const unsigned int nbchunks = height / LabelChunkLines + 1;
+	std::vector<LabelChunk> chunkref(nbchunks), chunkcmp(nbchunks);
+	std::vector<std::vector<unsigned long long> > chunkinter(nbchunks,std::vector<unsigned long long>(256,0));
+
+#pragma omp parallel for schedule(dynamic)
+	for(unsigned int k = 0; k < nbchunks; k++)
+	{
+		const unsigned int lbeg = k * LabelChunkLines;
+		const unsigned int lend = std::min(lbeg + LabelChunkLines, height + 1);
+		for(unsigned int l = lbeg; l < lend; l++)
+		{
+			if(l < height)
+			{
+				const unsigned char *rowref = labref + (std::size_t)width * l;
+				const unsigned char *rowcmp = labcmp + (std::size_t)width * l;
+				for(unsigned int c = 0; c < width; c++)
+				{
+					chunkref[k].area[rowref[c]]++;
+					chunkcmp[k].area[rowcmp[c]]++;
+					if(rowref[c] == rowcmp[c])
+						chunkinter[k][rowref[c]]++;
+				}
+			}
+			CornerLine(labref,width,height,l,options.background,chunkref[k].vert);
+			CornerLine(labcmp,width,height,l,options.background,chunkcmp[k].vert);
+		}
+	}
+
+	std::vector<LabelErrors> vecerr(0);
+	std::vector<std::vector<Eigen::Vector2d> > vertref(0), vertcmp(0);
+	for(unsigned int lab = 0; lab < 256; lab++)
+	{
+		if(lab == options.background)
+			continue;
+
+		LabelErrors err;
+		err.label = (unsigned char)lab;
+		for(unsigned int k = 0; k < nbchunks; k++)
+		{
+			err.arearef += chunkref[k].area[lab];
+			err.areacmp += chunkcmp[k].area[lab];
+			err.areainter += chunkinter[k][lab];
+		}
+		if(err.arearef == 0 && err.areacmp == 0)
+			continue;
+
+		// any area is infinitely larger than the area of a label missing in the reference
+		if(err.arearef == 0)
+			err.symdiff = std::numeric_limits<double>::infinity();
+		else
+			err.symdiff = (double)(err.arearef + err.areacmp - 2 * err.areainter)/(double)err.arearef;
+		err.iou = (double)err.areainter/(double)(err.arearef + err.areacmp - err.areainter);
+		vecerr.push_back(err);
+
+		// vertices of the chunks are kept in raster order
+		vertref.push_back(std::vector<Eigen::Vector2d>(0));
+		vertcmp.push_back(std::vector<Eigen::Vector2d>(0));
+		for(unsigned int k = 0; k < nbchunks; k++)
+		{
+			vertref.back().insert(vertref.back().end(),chunkref[k].vert[lab].begin(),chunkref[k].vert[lab].end());
+			vertcmp.back().insert(vertcmp.back().end(),chunkcmp[k].vert[lab].begin(),chunkcmp[k].vert[lab].end());
+			std::vector<Eigen::Vector2d>().swap(chunkref[k].vert[lab]);
+			std::vector<Eigen::Vector2d>().swap(chunkcmp[k].vert[lab]);
+		}
+	}
+
+#pragma omp parallel for schedule(dynamic)
+	for(unsigned int i = 0; i < vecerr.size(); i++)
+		vecerr[i].hausdist = HausDist(BoundaryGrid(vertref[i]),BoundaryGrid(vertcmp[i]));
+
+	return vecerr;
+}
@@ -0,0 +1,128 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file LabelError.h
+ *  \brief Computes the errors between the labels of two multi-label shapes
+ *  \author Bastien Durix
+ */
+
+#ifndef _LABELERROR_H_
+#define _LABELERROR_H_
+
+#include <vector>
+#include <shape/LabelShape.h>
+
+/**
+ *  \brief Lots of algorithms
+ */
+namespace algorithm
+{
+	/**
+	 *  \brief Evaluation algorithms
+	 */
+	namespace evaluation
+	{
+		/**
+		 *  \brief Label evaluation options structure
+		 */
+		struct OptionsLabelError
+		{
+			/**
+			 *  \brief Background label, which is not evaluated
+			 */
+			unsigned char background;
+
+			/**
+			 *  \brief Default constructor
+			 */
+			OptionsLabelError(unsigned char background_ = 0) :
+				background(background_) {}
+		};
+
+		/**
+		 *  \brief Errors on one label
+		 */
+		struct LabelErrors
+		{
+			/**
+			 *  \brief Evaluated label
+			 */
+			unsigned char label;
+
+			/**
+			 *  \brief Area of the label in the reference
+			 */
+			unsigned long long arearef;
+
+			/**
+			 *  \brief Area of the label in the compared shape
+			 */
+			unsigned long long areacmp;
+
+			/**
+			 *  \brief Area of the label in both shapes
+			 */
+			unsigned long long areainter;
+
+			/**
+			 *  \brief Symmetric difference area, relative to the reference area (infinite if the label is not in the reference)
+			 */
+			double symdiff;
+
+			/**
+			 *  \brief Intersection over union
+			 */
+			double iou;
+
+			/**
+			 *  \brief Hausdorff distance between the crack boundaries of the label (infinite if the label is in only one shape)
+			 */
+			double hausdist;
+
+			/**
+			 *  \brief Default constructor
+			 */
+			LabelErrors() :
+				label(0), arearef(0), areacmp(0), areainter(0), symdiff(0.0), iou(0.0), hausdist(0.0) {}
+		};
+
+		/**
+		 *  \brief Computes the errors of each label between two multi-label shapes
+		 *
+		 *  \details The areas and the crack boundary vertices of all labels are gathered in a single pass
+		 *           over both shapes. The Hausdorff distances of the labels are then computed in parallel.
+		 *           A label missing in one of the shapes gets an infinite Hausdorff distance and a null
+		 *           intersection over union, and an infinite symmetric difference if the reference misses it.
+		 *
+		 *  \param shpref  reference shape
+		 *  \param shpcmp  compared shape
+		 *  \param options evaluation options
+		 *
+		 *  \return errors of each label present in one of the shapes, by increasing label
+		 */
+		std::vector<LabelErrors> LabelError(const shape::LabelShape<2>::Ptr shpref, const shape::LabelShape<2>::Ptr shpcmp, const OptionsLabelError &options = OptionsLabelError());
+	}
+}
+
+#endif //_LABELERROR_H_
@@ -0,0 +1,147 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file MetricSet.cpp
+ *  \brief Computes several errors between a shape and a reference in a single pass
+ *  \author Bastien Durix
+ */
+
+#include "MetricSet.h"
+#include "DistanceMap.h"
+#include "ShapeError.h"
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ *  \brief Tests if a pixel of the shape is on its boundary
+ *
+ *  \param disc   shape data, row wise
+ *  \param stride number of bytes between two rows
+ *  \param width  shape width
+ *  \param height shape height
+ *  \param c      pixel column
+ *  \param l      pixel row
+ *
+ *  \return true if one of the 4-neighbors is out of the shape
+ */
+static inline bool IsBoundary(const unsigned char *disc, std::size_t stride, unsigned int width, unsigned int height, unsigned int c, unsigned int l)
+{
+	std::size_t ind = c + stride * l;
+	return c == 0 || c == width-1 || l == 0 || l == height-1 ||
+		   !disc[ind-1] || !disc[ind+1] || !disc[ind-stride] || !disc[ind+stride];
+}
+
+algorithm::evaluation::MetricSet::Values::Values() :
+	iou(std::numeric_limits<double>::quiet_NaN()),
+	dice(std::numeric_limits<double>::quiet_NaN()),
+	symdiff(std::numeric_limits<double>::quiet_NaN()),
+	hausdist(std::numeric_limits<double>::quiet_NaN()),
+	avgsurfdist(std::numeric_limits<double>::quiet_NaN())
+{}
+
+algorithm::evaluation::MetricSet::MetricSet(unsigned int metrics) : m_metrics(metrics)
+{}
+
+unsigned int algorithm::evaluation::MetricSet::getMetrics() const
+{
+	return m_metrics;
+}
+
+algorithm::evaluation::MetricSet::Values algorithm::evaluation::MetricSet::evaluate(const shape::DiscreteShape<2>::Ptr shpref, const shape::DiscreteShape<2>::Ptr shpcmp) const
+{
+	if(shpref->getWidth() != shpcmp->getWidth() || shpref->getHeight() != shpcmp->getHeight())
+		throw std::logic_error("algorithm::evaluation::MetricSet::evaluate : shapes sizes differ");
+
+	unsigned int width = shpref->getWidth();
+	unsigned int height = shpref->getHeight();
+	const shape::DiscreteShape<2> &shref = *shpref;
+	const shape::DiscreteShape<2> &shcmp = *shpcmp;
+	const unsigned char *discref = shref.getData();
+	const unsigned char *disccmp = shcmp.getData();
+	const std::size_t strideref = shref.getStride();
+	const std::size_t stridecmp = shcmp.getStride();
+	bool withdist = (m_metrics & distance) != 0;
+
+	//first step: areas and boundaries, in one pass over both shapes
+	unsigned long long arearef = 0, areacmp = 0, areainter = 0;
+	std::vector<std::size_t> bndref(0), bndcmp(0);
+#pragma omp parallel
+	{
+		std::vector<std::size_t> locref(0), loccmp(0);
+
+#pragma omp for reduction(+:arearef,areacmp,areainter)
+		for(unsigned int l = 0; l < height; l++)
+		{
+			for(unsigned int c = 0; c < width; c++)
+			{
+				std::size_t ind = c + (std::size_t)width * l;
+				bool inref = discref[c + strideref * l] != 0;
+				bool incmp = disccmp[c + stridecmp * l] != 0;
+				arearef += inref;
+				areacmp += incmp;
+				areainter += (inref && incmp);
+
+				if(withdist)
+				{
+					if(inref && IsBoundary(discref,strideref,width,height,c,l))
+						locref.push_back(ind);
+					if(incmp && IsBoundary(disccmp,stridecmp,width,height,c,l))
+						loccmp.push_back(ind);
+				}
+			}
+		}
+
+#pragma omp critical
+		{
+			bndref.insert(bndref.end(),locref.begin(),locref.end());
+			bndcmp.insert(bndcmp.end(),loccmp.begin(),loccmp.end());
+		}
+	}
+
+	Values val;
+	if(m_metrics & iou)
+		val.iou = (double)areainter / (double)(arearef + areacmp - areainter);
+	if(m_metrics & dice)
+		val.dice = 2.0 * (double)areainter / (double)(arearef + areacmp);
+	if(m_metrics & symdiff)
+		val.symdiff = (double)(arearef + areacmp - 2*areainter) / (double)arearef;
+
+	//second step: distances, read in the distance maps of the boundaries
+	if(withdist)
+	{
+		// row wise order, independent of the threads scheduling
+		std::sort(bndref.begin(),bndref.end());
+		std::sort(bndcmp.begin(),bndcmp.end());
+
+		DistanceMap dismapref(width,height,bndref);
+		DistanceMap dismapcmp(width,height,bndcmp);
+		if(m_metrics & hausdist)
+			val.hausdist = HausDist(dismapref,dismapcmp);
+		if(m_metrics & avgsurfdist)
+			val.avgsurfdist = AvgSurfDist(dismapref,dismapcmp);
+	}
+
+	return val;
+}
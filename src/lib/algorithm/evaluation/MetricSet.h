@@ -0,0 +1,142 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file MetricSet.h
+ *  \brief Computes several errors between a shape and a reference in a single pass
+ *  \author Bastien Durix
+ */
+
+#ifndef _METRICSET_H_
+#define _METRICSET_H_
+
+#include <shape/DiscreteShape.h>
+
+/**
+ *  \brief Lots of algorithms
+ */
+namespace algorithm
+{
+	/**
+	 *  \brief Evaluation algorithms
+	 */
+	namespace evaluation
+	{
+		/**
+		 *  \brief Set of metrics, evaluated together
+		 *
+		 *  \details Areas and boundary pixels of both shapes are gathered in one pass over the shapes,
+		 *           the distance maps of the boundaries are only computed when a distance is requested
+		 */
+		class MetricSet
+		{
+			public:
+				/**
+				 *  \brief Available metrics, to be combined as a bitmask
+				 */
+				enum Metric : unsigned int
+				{
+					iou         = 1u << 0,
+					dice        = 1u << 1,
+					symdiff     = 1u << 2,
+					hausdist    = 1u << 3,
+					avgsurfdist = 1u << 4,
+					area        = iou | dice | symdiff,
+					distance    = hausdist | avgsurfdist,
+					all         = area | distance
+				};
+
+				/**
+				 *  \brief Values of the metrics (NaN when not requested)
+				 */
+				struct Values
+				{
+					/**
+					 *  \brief Intersection over union
+					 */
+					double iou;
+
+					/**
+					 *  \brief Dice coefficient
+					 */
+					double dice;
+
+					/**
+					 *  \brief Symmetric difference area, divided by the reference area
+					 */
+					double symdiff;
+
+					/**
+					 *  \brief Hausdorff distance between the boundary pixels
+					 *
+					 *  \details Pixels of the shapes with a 4-neighbor outside, which differs from the Hausdorff
+					 *           distance between the pixel corners of HausDist(BoundaryGrid,BoundaryGrid)
+					 */
+					double hausdist;
+
+					/**
+					 *  \brief Average symmetric surface distance between the boundary pixels
+					 */
+					double avgsurfdist;
+
+					/**
+					 *  \brief Default constructor, all values set to NaN
+					 */
+					Values();
+				};
+
+			protected:
+				/**
+				 *  \brief Bitmask of the requested metrics
+				 */
+				unsigned int m_metrics;
+
+			public:
+				/**
+				 *  \brief Constructor
+				 *
+				 *  \param metrics bitmask of the requested metrics
+				 */
+				MetricSet(unsigned int metrics = all);
+
+				/**
+				 *  \brief Requested metrics getter
+				 *
+				 *  \return bitmask of the requested metrics
+				 */
+				unsigned int getMetrics() const;
+
+				/**
+				 *  \brief Computes the requested metrics
+				 *
+				 *  \param shpref reference shape
+				 *  \param shpcmp compared shape
+				 *
+				 *  \return values of the requested metrics
+				 */
+				Values evaluate(const shape::DiscreteShape<2>::Ptr shpref, const shape::DiscreteShape<2>::Ptr shpcmp) const;
+		};
+	}
+}
+
+#endif //_METRICSET_H_
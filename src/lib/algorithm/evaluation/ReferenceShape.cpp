@@ -0,0 +1,151 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file ReferenceShape.cpp
+ *  \brief Reference shape, caching what is needed to evaluate many shapes against it
+ *  \author Bastien Durix
+ */
+
+#include "ReferenceShape.h"
+#include "ShapeError.h"
+#include <limits>
+#include <stdexcept>
+#include <exception>
+#include <algorithm/extractboundary/BorderFollowing.h>
+
+algorithm::evaluation::ReferenceShape::ReferenceShape(const shape::DiscreteShape<2>::Ptr shpref, const OptionsReference &options) :
+	m_shape(shpref),
+	m_boundary(algorithm::extractboundary::BorderFollowing(shpref)),
+	m_grid(m_boundary),
+	m_dismap(options.distmap ? new DistanceMap(shpref) : nullptr),
+	m_area(0)
+{
+	const shape::DiscreteShape<2> &shp = *m_shape;
+	const unsigned char *disc = shp.getData();
+	const std::size_t stride = shp.getStride();
+	unsigned int area = 0;
+#pragma omp parallel for reduction(+:area)
+	for(unsigned int l = 0; l < shp.getHeight(); l++)
+		for(unsigned int c = 0; c < shp.getWidth(); c++)
+			area += (disc[c + stride * l] != 0);
+	m_area = area;
+}
+
+const shape::DiscreteShape<2>::Ptr algorithm::evaluation::ReferenceShape::getShape() const
+{
+	return m_shape;
+}
+
+const boundary::DiscreteBoundary<2>::Ptr algorithm::evaluation::ReferenceShape::getBoundary() const
+{
+	return m_boundary;
+}
+
+const algorithm::evaluation::BoundaryGrid& algorithm::evaluation::ReferenceShape::getGrid() const
+{
+	return m_grid;
+}
+
+const algorithm::evaluation::DistanceMap::Ptr algorithm::evaluation::ReferenceShape::getDistanceMap() const
+{
+	return m_dismap;
+}
+
+unsigned int algorithm::evaluation::ReferenceShape::getArea() const
+{
+	return m_area;
+}
+
+double algorithm::evaluation::ReferenceShape::symDiffArea(const shape::DiscreteShape<2>::Ptr shpcmp) const
+{
+	if(m_shape->getWidth() != shpcmp->getWidth() || m_shape->getHeight() != shpcmp->getHeight())
+		throw std::logic_error("algorithm::evaluation::ReferenceShape::symDiffArea : shapes sizes differ");
+
+	const shape::DiscreteShape<2> &shpref = *m_shape;
+	const shape::DiscreteShape<2> &shpdata = *shpcmp;
+	const unsigned char *discref = shpref.getData();
+	const unsigned char *disccmp = shpdata.getData();
+	const std::size_t strideref = shpref.getStride();
+	const std::size_t stridecmp = shpdata.getStride();
+	unsigned int areadiff = 0;
+#pragma omp parallel for reduction(+:areadiff)
+	for(unsigned int l = 0; l < shpref.getHeight(); l++)
+		for(unsigned int c = 0; c < shpref.getWidth(); c++)
+			areadiff += ((discref[c + strideref * l] != 0) != (disccmp[c + stridecmp * l] != 0));
+
+	return (double)areadiff/(double)m_area;
+}
+
+double algorithm::evaluation::ReferenceShape::hausDist(const boundary::DiscreteBoundary<2>::Ptr bndcmp) const
+{
+	return HausDist(m_grid,BoundaryGrid(bndcmp));
+}
+
+algorithm::evaluation::ReferenceShape::Errors algorithm::evaluation::ReferenceShape::evaluate(const shape::DiscreteShape<2>::Ptr shpcmp) const
+{
+	Errors err;
+	err.symdiff = symDiffArea(shpcmp);
+	err.hausdist = hausDist(algorithm::extractboundary::BorderFollowing(shpcmp));
+
+	if(m_dismap)
+	{
+		DistanceMap dismap(shpcmp);
+		err.hausdistdt = HausDist(*m_dismap,dismap);
+		err.avgsurfdist = AvgSurfDist(*m_dismap,dismap);
+	}
+	else
+	{
+		err.hausdistdt = std::numeric_limits<double>::quiet_NaN();
+		err.avgsurfdist = std::numeric_limits<double>::quiet_NaN();
+	}
+
+	return err;
+}
+
+std::vector<algorithm::evaluation::ReferenceShape::Errors> algorithm::evaluation::ReferenceShape::evaluate(const std::vector<shape::DiscreteShape<2>::Ptr> &vecshp) const
+{
+	std::vector<Errors> vecerr(vecshp.size());
+	std::exception_ptr except = nullptr;
+
+	// one shape per thread, exceptions are forwarded after the loop
+#pragma omp parallel for schedule(dynamic)
+	for(unsigned int i = 0; i < vecshp.size(); i++)
+	{
+		try
+		{
+			vecerr[i] = evaluate(vecshp[i]);
+		}
+		catch(...)
+		{
+#pragma omp critical
+			if(!except)
+				except = std::current_exception();
+		}
+	}
+
+	if(except)
+		std::rethrow_exception(except);
+
+	return vecerr;
+}
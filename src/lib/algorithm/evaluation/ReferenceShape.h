@@ -0,0 +1,222 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file ReferenceShape.h
+ *  \brief Reference shape, caching what is needed to evaluate many shapes against it
+ *  \author Bastien Durix
+ */
+
+#ifndef _REFERENCESHAPE_H_
+#define _REFERENCESHAPE_H_
+
+#include <memory>
+#include <vector>
+#include <shape/DiscreteShape.h>
+#include <boundary/DiscreteBoundary2.h>
+#include "BoundaryGrid.h"
+#include "DistanceMap.h"
+
+/**
+ *  \brief Lots of algorithms
+ */
+namespace algorithm
+{
+	/**
+	 *  \brief Evaluation algorithms
+	 */
+	namespace evaluation
+	{
+		/**
+		 *  \brief Reference evaluation options
+		 */
+		struct OptionsReference
+		{
+			/**
+			 *  \brief Computes the distances between the boundary pixels (distance maps of the shapes)
+			 */
+			bool distmap;
+
+			/**
+			 *  \brief Default constructor
+			 */
+			OptionsReference(bool distmap_ = false) :
+				distmap(distmap_) {}
+		};
+
+		/**
+		 *  \brief Reference shape
+		 *
+		 *  \details The boundary of the reference, its spatial index, its area and, on request, its distance map
+		 *           are computed once at construction, and reused for each evaluated shape
+		 */
+		class ReferenceShape
+		{
+			public:
+				/**
+				 *  \brief Reference shape shared pointer
+				 */
+				using Ptr = std::shared_ptr<ReferenceShape>;
+
+				/**
+				 *  \brief Errors of a shape relatively to the reference
+				 */
+				struct Errors
+				{
+					/**
+					 *  \brief Symmetric difference area, divided by the reference area
+					 */
+					double symdiff;
+
+					/**
+					 *  \brief Hausdorff distance between the boundaries vertices
+					 */
+					double hausdist;
+
+					/**
+					 *  \brief Hausdorff distance between the boundary pixels (NaN without the distmap option)
+					 */
+					double hausdistdt;
+
+					/**
+					 *  \brief Average symmetric surface distance between the boundary pixels (NaN without the distmap option)
+					 */
+					double avgsurfdist;
+
+					/**
+					 *  \brief Default constructor
+					 */
+					Errors(double symdiff_ = 0.0, double hausdist_ = 0.0, double hausdistdt_ = 0.0, double avgsurfdist_ = 0.0) :
+						symdiff(symdiff_), hausdist(hausdist_), hausdistdt(hausdistdt_), avgsurfdist(avgsurfdist_) {}
+				};
+
+			protected:
+				/**
+				 *  \brief Reference shape
+				 */
+				shape::DiscreteShape<2>::Ptr m_shape;
+
+				/**
+				 *  \brief Boundary of the reference
+				 */
+				boundary::DiscreteBoundary<2>::Ptr m_boundary;
+
+				/**
+				 *  \brief Spatial index of the boundary vertices
+				 */
+				BoundaryGrid m_grid;
+
+				/**
+				 *  \brief Distance map of the boundary pixels, null without the distmap option
+				 */
+				DistanceMap::Ptr m_dismap;
+
+				/**
+				 *  \brief Number of pixels in the reference
+				 */
+				unsigned int m_area;
+
+			public:
+				/**
+				 *  \brief Constructor
+				 *
+				 *  \param shpref  reference shape
+				 *  \param options evaluation options
+				 */
+				ReferenceShape(const shape::DiscreteShape<2>::Ptr shpref, const OptionsReference &options = OptionsReference());
+
+				/**
+				 *  \brief Shape getter
+				 *
+				 *  \return reference shape
+				 */
+				const shape::DiscreteShape<2>::Ptr getShape() const;
+
+				/**
+				 *  \brief Boundary getter
+				 *
+				 *  \return boundary of the reference
+				 */
+				const boundary::DiscreteBoundary<2>::Ptr getBoundary() const;
+
+				/**
+				 *  \brief Spatial index getter
+				 *
+				 *  \return spatial index of the boundary vertices
+				 */
+				const BoundaryGrid& getGrid() const;
+
+				/**
+				 *  \brief Distance map getter
+				 *
+				 *  \return distance map of the boundary pixels, null without the distmap option
+				 */
+				const DistanceMap::Ptr getDistanceMap() const;
+
+				/**
+				 *  \brief Area getter
+				 *
+				 *  \return number of pixels in the reference
+				 */
+				unsigned int getArea() const;
+
+				/**
+				 *  \brief Computes the symmetric difference area with a shape
+				 *
+				 *  \param shpcmp compared shape
+				 *
+				 *  \return symmetric difference area divided by the reference area
+				 */
+				double symDiffArea(const shape::DiscreteShape<2>::Ptr shpcmp) const;
+
+				/**
+				 *  \brief Computes the Hausdorff distance with a boundary
+				 *
+				 *  \param bndcmp compared boundary
+				 *
+				 *  \return Hausdorff distance between the boundaries vertices (infinite if only one boundary is empty)
+				 */
+				double hausDist(const boundary::DiscreteBoundary<2>::Ptr bndcmp) const;
+
+				/**
+				 *  \brief Computes all the errors of a shape
+				 *
+				 *  \param shpcmp compared shape
+				 *
+				 *  \return errors of the shape
+				 */
+				Errors evaluate(const shape::DiscreteShape<2>::Ptr shpcmp) const;
+
+				/**
+				 *  \brief Computes all the errors of several shapes, in parallel
+				 *
+				 *  \param vecshp compared shapes
+				 *
+				 *  \return errors of each shape
+				 */
+				std::vector<Errors> evaluate(const std::vector<shape::DiscreteShape<2>::Ptr> &vecshp) const;
+		};
+	}
+}
+
+#endif //_REFERENCESHAPE_H_
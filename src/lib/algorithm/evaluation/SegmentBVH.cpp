@@ -0,0 +1,80 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file SegmentBVH.cpp
+ *  \brief Bounding volume hierarchy over the segments of a boundary
+ *  \author Bastien Durix
+ */
+
+#include "SegmentBVH.h"
+#include <algorithm>
+#include <stdexcept>
+
+Eigen::Vector2d algorithm::evaluation::Segment::getMin() const
+{
+	return pt1.cwiseMin(pt2);
+}
+
+Eigen::Vector2d algorithm::evaluation::Segment::getMax() const
+{
+	return pt1.cwiseMax(pt2);
+}
+
+double algorithm::evaluation::Segment::distance(const Eigen::Vector2d &pt) const
+{
+	Eigen::Vector2d vec = pt2 - pt1;
+	double sqlen = vec.squaredNorm();
+	double t = sqlen == 0.0 ? 0.0 : std::min(std::max((pt - pt1).dot(vec) / sqlen, 0.0), 1.0);
+	return (pt1 + t * vec - pt).norm();
+}
+
+algorithm::evaluation::SegmentBVH::SegmentBVH(const std::vector<Eigen::Vector2d> &pt1, const std::vector<Eigen::Vector2d> &pt2)
+{
+	if(pt1.size() != pt2.size())
+		throw std::logic_error("algorithm::evaluation::SegmentBVH : one end per segment start is needed");
+
+	m_primitives.resize(pt1.size());
+	for(unsigned int i = 0; i < pt1.size(); i++)
+		m_primitives[i] = Segment{pt1[i],pt2[i]};
+
+	build();
+}
+
+algorithm::evaluation::SegmentBVH::SegmentBVH(const boundary::DiscreteBoundary<2>::Ptr bnd)
+{
+	m_primitives.resize(bnd->getNbVertices());
+	boundary::DiscreteBoundary<2>::VerticesView vert = bnd->getView();
+	for(unsigned int i = 0; i < vert.size; i++)
+	{
+		unsigned int next = bnd->getNext(i);
+		m_primitives[i] = Segment{Eigen::Vector2d(vert.x[i],vert.y[i]),Eigen::Vector2d(vert.x[next],vert.y[next])};
+	}
+
+	build();
+}
+
+unsigned int algorithm::evaluation::SegmentBVH::getNbSegments() const
+{
+	return getNbPrimitives();
+}
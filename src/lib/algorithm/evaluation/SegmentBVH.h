@@ -0,0 +1,126 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file SegmentBVH.h
+ *  \brief Bounding volume hierarchy over the segments of a boundary
+ *  \author Bastien Durix
+ */
+
+#ifndef _SEGMENTBVH_H_
+#define _SEGMENTBVH_H_
+
+#include <memory>
+#include <vector>
+#include <Eigen/Dense>
+#include <boundary/DiscreteBoundary2.h>
+#include "BVH.h"
+
+/**
+ *  \brief Lots of algorithms
+ */
+namespace algorithm
+{
+	/**
+	 *  \brief Evaluation algorithms
+	 */
+	namespace evaluation
+	{
+		/**
+		 *  \brief Segment indexed in a hierarchy
+		 */
+		struct Segment
+		{
+			/**
+			 *  \brief First extremity
+			 */
+			Eigen::Vector2d pt1;
+
+			/**
+			 *  \brief Second extremity
+			 */
+			Eigen::Vector2d pt2;
+
+			/**
+			 *  \brief Lower corner of the bounding box
+			 *
+			 *  \return lower corner
+			 */
+			Eigen::Vector2d getMin() const;
+
+			/**
+			 *  \brief Upper corner of the bounding box
+			 *
+			 *  \return upper corner
+			 */
+			Eigen::Vector2d getMax() const;
+
+			/**
+			 *  \brief Distance to a point
+			 *
+			 *  \param pt point
+			 *
+			 *  \return distance to the nearest point of the segment
+			 */
+			double distance(const Eigen::Vector2d &pt) const;
+		};
+
+		/**
+		 *  \brief Bounding volume hierarchy over a set of segments
+		 */
+		class SegmentBVH : public BVH<Segment>
+		{
+			public:
+				/**
+				 *  \brief Hierarchy shared pointer
+				 */
+				using Ptr = std::shared_ptr<SegmentBVH>;
+
+				/**
+				 *  \brief Constructor
+				 *
+				 *  \details Throws if both vectors do not have the same size
+				 *
+				 *  \param pt1 first extremities of the segments
+				 *  \param pt2 second extremities of the segments
+				 */
+				SegmentBVH(const std::vector<Eigen::Vector2d> &pt1, const std::vector<Eigen::Vector2d> &pt2);
+
+				/**
+				 *  \brief Constructor, from the segments linking each vertex of a boundary to the next one
+				 *
+				 *  \param bnd boundary whose segments are indexed
+				 */
+				SegmentBVH(const boundary::DiscreteBoundary<2>::Ptr bnd);
+
+				/**
+				 *  \brief Number of segments getter
+				 *
+				 *  \return number of indexed segments
+				 */
+				unsigned int getNbSegments() const;
+		};
+	}
+}
+
+#endif //_SEGMENTBVH_H_
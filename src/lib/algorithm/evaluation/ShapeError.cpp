@@ -28,14 +28,31 @@ SOFTWARE.
  */
 
 #include "ShapeError.h"
+#include <algorithm/simplification/DouglasPeucker.h>
 #include <opencv2/imgproc/imgproc.hpp>
 #include <opencv2/highgui/highgui.hpp>
+#include <cmath>
+#include <limits>
+#include <atomic>
+#include <random>
+#include <algorithm>
+#include <queue>
+#include <stdexcept>
 
 double algorithm::evaluation::SymDiffArea(const shape::DiscreteShape<2>::Ptr shpref, const shape::DiscreteShape<2>::Ptr shpcmp)
 {
-	cv::Mat img(shpref->getHeight(),shpref->getWidth(),CV_8U);
-	cv::Mat im_shape(shpref->getHeight(),shpref->getWidth(),CV_8U,&shpref->getContainer()[0]);
-	cv::Mat im_proj(shpcmp->getHeight(),shpcmp->getWidth(),CV_8U,&shpcmp->getContainer()[0]);
+	const shape::DiscreteShape<2> &shref = *shpref;
+	const shape::DiscreteShape<2> &shcmp = *shpcmp;
+
+	// pixels outside of both bounding boxes are empty in both shapes
+	shape::DiscreteShape<2>::BoundingBox bbox = shref.getBoundingBox().merge(shcmp.getBoundingBox());
+	if(bbox.isEmpty())
+		return std::numeric_limits<double>::quiet_NaN();
+	cv::Rect roi(bbox.cmin,bbox.lmin,bbox.cmax-bbox.cmin,bbox.lmax-bbox.lmin);
+
+	cv::Mat img(roi.height,roi.width,CV_8U);
+	cv::Mat im_shape = cv::Mat(shref.getHeight(),shref.getWidth(),CV_8U,(void*)shref.getData(),shref.getStride())(roi);
+	cv::Mat im_proj = cv::Mat(shcmp.getHeight(),shcmp.getWidth(),CV_8U,(void*)shcmp.getData(),shcmp.getStride())(roi);
 	cv::absdiff(im_shape,im_proj,img);
 
 	double dist = cv::sum(img)(0)/cv::sum(im_shape)(0);
@@ -43,85 +60,726 @@ double algorithm::evaluation::SymDiffArea(const shape::DiscreteShape<2>::Ptr shp
 	return dist;
 }
 
-double algorithm::evaluation::HausDist(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2)
+double algorithm::evaluation::SymDiffArea(const shape::PackedShape<2>::Ptr shpref, const shape::PackedShape<2>::Ptr shpcmp)
 {
-	// the optimisation is close to 0...
-	double distmax = 0;
-#pragma omp parallel for
-	for(unsigned int i = 0; i < bnd1->getNbVertices(); i++)
+	if(shpref->getWidth() != shpcmp->getWidth() || shpref->getHeight() != shpcmp->getHeight())
+		throw std::logic_error("algorithm::evaluation::SymDiffArea : shapes sizes differ");
+
+	const shape::PackedShape<2> &shref = *shpref;
+	const shape::PackedShape<2> &shcmp = *shpcmp;
+	const uint64_t *wordsref = shref.getData();
+	const uint64_t *wordscmp = shcmp.getData();
+	const std::size_t nbwords = (std::size_t)shref.getRowWords() * shref.getHeight();
+
+	// padding bits are zero in both shapes, no masking needed
+	unsigned long long areadiff = 0, arearef = 0;
+#pragma omp parallel for reduction(+:areadiff,arearef)
+	for(std::size_t i = 0; i < nbwords; i++)
 	{
-		double distcur = 0;
-		Eigen::Vector2d pt1 = bnd1->getVertex(i).getCoords();
-		for(unsigned int j = 0; j < bnd2->getNbVertices(); j++)
+		areadiff += shape::PopCount(wordsref[i] ^ wordscmp[i]);
+		arearef  += shape::PopCount(wordsref[i]);
+	}
+
+	return (double)areadiff/(double)arearef;
+}
+
+double algorithm::evaluation::SymDiffArea(const shape::RLEShape<2>::Ptr shpref, const shape::RLEShape<2>::Ptr shpcmp)
+{
+	if(shpref->getWidth() != shpcmp->getWidth() || shpref->getHeight() != shpcmp->getHeight())
+		throw std::logic_error("algorithm::evaluation::SymDiffArea : shapes sizes differ");
+
+	unsigned long long areadiff = 0, arearef = 0;
+#pragma omp parallel for reduction(+:areadiff,arearef) schedule(dynamic,64)
+	for(unsigned int l = 0; l < shpref->getHeight(); l++)
+	{
+		const std::vector<shape::RLEShape<2>::Run> &runsref = shpref->getRow(l);
+		const std::vector<shape::RLEShape<2>::Run> &runscmp = shpcmp->getRow(l);
+
+		unsigned long long lenref = 0, lencmp = 0, leninter = 0;
+		for(unsigned int i = 0; i < runsref.size(); i++)
+			lenref += runsref[i].end - runsref[i].beg;
+		for(unsigned int j = 0; j < runscmp.size(); j++)
+			lencmp += runscmp[j].end - runscmp[j].beg;
+
+		// both lists are sorted: the run ending first cannot overlap the next ones
+		for(unsigned int i = 0, j = 0; i < runsref.size() && j < runscmp.size();)
 		{
-			Eigen::Vector2d pt2 = bnd2->getVertex(j).getCoords();
-			double dist = (pt2 - pt1).squaredNorm();
-			if(dist < distcur || j == 0)
-				distcur = dist;
+			unsigned int beg = std::max(runsref[i].beg,runscmp[j].beg);
+			unsigned int end = std::min(runsref[i].end,runscmp[j].end);
+			if(beg < end)
+				leninter += end - beg;
+			if(runsref[i].end < runscmp[j].end)
+				i++;
+			else
+				j++;
+		}
+
+		areadiff += lenref + lencmp - 2 * leninter;
+		arearef += lenref;
+	}
+
+	return (double)areadiff/(double)arearef;
+}
+
+double algorithm::evaluation::HausDist(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2, const OptionsHausDist &options)
+{
+	HausDistMethod method = options.method;
+	if(method == HausDistMethod::automatic)
+	{
+		if((double)bnd1->getNbVertices() * (double)bnd2->getNbVertices() > options.threshold)
+			method = HausDistMethod::indexed;
+		else
+			method = HausDistMethod::bruteforce;
+	}
+
+	double distmax = 0.0;
+	switch(method)
+	{
+		case HausDistMethod::indexed:
+			distmax = HausDist(BoundaryGrid(bnd1),BoundaryGrid(bnd2));
+			break;
+		case HausDistMethod::earlybreak:
+			distmax = HausDistEarlyBreak(bnd1,bnd2);
+			break;
+		default:
+			distmax = HausDistBruteForce(bnd1,bnd2);
+			break;
+	}
+	return distmax;
+}
+
+double algorithm::evaluation::HausDist(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2, HausDistDetails &details, bool pervertex)
+{
+	details = HausDistDetails();
+	if(bnd1->getNbVertices() == 0 && bnd2->getNbVertices() == 0)
+		return 0.0;
+	if(bnd1->getNbVertices() == 0 || bnd2->getNbVertices() == 0)
+	{
+		details.hausdist = std::numeric_limits<double>::infinity();
+		return details.hausdist;
+	}
+
+	BoundaryGrid grid1(bnd1), grid2(bnd2);
+	if(pervertex)
+	{
+		details.dist1.resize(bnd1->getNbVertices());
+		details.dist2.resize(bnd2->getNbVertices());
+	}
+
+	// witness: largest distance, then lowest indices, whatever the threads scheduling
+	double distmax = -1.0;
+	unsigned int ind1 = 0, ind2 = 0;
+#pragma omp parallel
+	{
+		double distloc = -1.0;
+		unsigned int indloc1 = 0, indloc2 = 0;
+
+		for(unsigned int k = 0; k < 2; k++)
+		{
+			const BoundaryGrid &gridfrom = k == 0 ? grid1 : grid2;
+			const BoundaryGrid &gridto   = k == 0 ? grid2 : grid1;
+			std::vector<double> &vecdist = k == 0 ? details.dist1 : details.dist2;
+#pragma omp for nowait
+			for(unsigned int i = 0; i < gridfrom.getNbVertices(); i++)
+			{
+				unsigned int indfrom = gridfrom.getIndex(i), indto;
+				double distcur = gridto.nearestSqDist(gridfrom.getCoordinates(i),indto);
+				if(pervertex)
+					vecdist[indfrom] = std::sqrt(distcur);
+
+				unsigned int indcur1 = k == 0 ? indfrom : indto;
+				unsigned int indcur2 = k == 0 ? indto : indfrom;
+				if(distcur > distloc || (distcur == distloc && std::make_pair(indcur1,indcur2) < std::make_pair(indloc1,indloc2)))
+				{
+					distloc = distcur;
+					indloc1 = indcur1;
+					indloc2 = indcur2;
+				}
+			}
 		}
 #pragma omp critical
 		{
-			if(distcur > distmax)
-				distmax = distcur;
+			if(distloc > distmax || (distloc == distmax && std::make_pair(indloc1,indloc2) < std::make_pair(ind1,ind2)))
+			{
+				distmax = distloc;
+				ind1 = indloc1;
+				ind2 = indloc2;
+			}
+		}
+	}
+
+	details.hausdist = std::sqrt(distmax);
+	details.index1 = ind1;
+	details.index2 = ind2;
+	details.point1 = bnd1->getCoordinates(ind1);
+	details.point2 = bnd2->getCoordinates(ind2);
+
+	return details.hausdist;
+}
+
+double algorithm::evaluation::HausDistBruteForce(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2)
+{
+	if(bnd1->getNbVertices() == 0 && bnd2->getNbVertices() == 0)
+		return 0.0;
+	if(bnd1->getNbVertices() == 0 || bnd2->getNbVertices() == 0)
+		return std::numeric_limits<double>::infinity();
+
+	double distmax = DirectedSqHausDist(bnd1->getView(),bnd2->getView());
+	
+	// symetric
+	distmax = std::max(distmax,DirectedSqHausDist(bnd2->getView(),bnd1->getView()));
+
+	return std::sqrt(distmax);
+}
+
+/**
+ *  \brief Segments of a boundary, from each vertex to the next one
+ *
+ *  \param bnd boundary
+ *  \param x   abscissas of the first extremities
+ *  \param y   ordinates of the first extremities
+ *  \param dx  abscissas of the segments vectors
+ *  \param dy  ordinates of the segments vectors
+ */
+static void BoundarySegments(const boundary::DiscreteBoundary<2>::Ptr bnd, std::vector<double> &x, std::vector<double> &y, std::vector<double> &dx, std::vector<double> &dy)
+{
+	boundary::DiscreteBoundary<2>::VerticesView vert = bnd->getView();
+	x.assign(vert.x,vert.x + vert.size);
+	y.assign(vert.y,vert.y + vert.size);
+	dx.resize(vert.size);
+	dy.resize(vert.size);
+	for(unsigned int i = 0; i < vert.size; i++)
+	{
+		unsigned int next = bnd->getNext(i);
+		dx[i] = vert.x[next] - vert.x[i];
+		dy[i] = vert.y[next] - vert.y[i];
+	}
+}
+
+/**
+ *  \brief Directed Hausdorff distance between vertices and segments
+ *
+ *  \param vert vertices from which the distance is computed
+ *  \param bnd  boundary whose segments the distance is computed to
+ *
+ *  \return maximal squared distance of the vertices to the segments
+ */
+static double HausDistSegmentsDirected(const boundary::DiscreteBoundary<2>::VerticesView &vert, const boundary::DiscreteBoundary<2>::Ptr bnd)
+{
+	std::vector<double> segx(0), segy(0), segdx(0), segdy(0);
+	BoundarySegments(bnd,segx,segy,segdx,segdy);
+	const double *x = segx.data(), *y = segy.data(), *dx = segdx.data(), *dy = segdy.data();
+	unsigned int nbseg = segx.size();
+
+	double distmax = 0.0;
+#pragma omp parallel for reduction(max:distmax)
+	for(unsigned int i = 0; i < vert.size; i++)
+	{
+		double px = vert.x[i], py = vert.y[i];
+		double distcur = std::numeric_limits<double>::infinity();
+#pragma omp simd reduction(min:distcur)
+		for(unsigned int j = 0; j < nbseg; j++)
+		{
+			double sqlen = dx[j] * dx[j] + dy[j] * dy[j];
+			double t = ((px - x[j]) * dx[j] + (py - y[j]) * dy[j]) / (sqlen > 0.0 ? sqlen : 1.0);
+			t = t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+			double ex = x[j] + t * dx[j] - px;
+			double ey = y[j] + t * dy[j] - py;
+			double dist = ex * ex + ey * ey;
+			distcur = dist < distcur ? dist : distcur;
 		}
+		if(distcur > distmax)
+			distmax = distcur;
 	}
+	return distmax;
+}
+
+double algorithm::evaluation::HausDistSegmentsBruteForce(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2)
+{
+	if(bnd1->getNbVertices() == 0 && bnd2->getNbVertices() == 0)
+		return 0.0;
+	if(bnd1->getNbVertices() == 0 || bnd2->getNbVertices() == 0)
+		return std::numeric_limits<double>::infinity();
+
+	double distmax = HausDistSegmentsDirected(bnd1->getView(),bnd2);
 	
 	// symetric
+	distmax = std::max(distmax,HausDistSegmentsDirected(bnd2->getView(),bnd1));
+
+	return std::sqrt(distmax);
+}
+
+/**
+ *  \brief Directed Hausdorff distance between vertices and indexed segments
+ *
+ *  \param vert vertices from which the distance is computed
+ *  \param bvh  hierarchy of the segments to which the distance is computed
+ *
+ *  \return maximal distance of the vertices to the segments
+ */
+static double HausDistSegmentsDirected(const boundary::DiscreteBoundary<2>::VerticesView &vert, const algorithm::evaluation::SegmentBVH &bvh)
+{
+	double distmax = 0.0;
+#pragma omp parallel for reduction(max:distmax) schedule(dynamic,256)
+	for(unsigned int i = 0; i < vert.size; i++)
+	{
+		double distcur = bvh.distance(Eigen::Vector2d(vert.x[i],vert.y[i]));
+		if(distcur > distmax)
+			distmax = distcur;
+	}
+	return distmax;
+}
+
+double algorithm::evaluation::HausDistSegments(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2)
+{
+	if(bnd1->getNbVertices() == 0 && bnd2->getNbVertices() == 0)
+		return 0.0;
+	if(bnd1->getNbVertices() == 0 || bnd2->getNbVertices() == 0)
+		return std::numeric_limits<double>::infinity();
+
+	double distmax = HausDistSegmentsDirected(bnd1->getView(),SegmentBVH(bnd2));
+	
+	// symetric
+	distmax = std::max(distmax,HausDistSegmentsDirected(bnd2->getView(),SegmentBVH(bnd1)));
+
+	return distmax;
+}
+
+double algorithm::evaluation::HausDistSimplified(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2, double tolerance)
+{
+	if(bnd1->getNbVertices() == 0 && bnd2->getNbVertices() == 0)
+		return 0.0;
+	if(bnd1->getNbVertices() == 0 || bnd2->getNbVertices() == 0)
+		return std::numeric_limits<double>::infinity();
 	
-#pragma omp parallel for
-	for(unsigned int j = 0; j < bnd2->getNbVertices(); j++)
+	// each point of the original segments is within tolerance of the simplified ones, and conversely
+	boundary::DiscreteBoundary<2>::Ptr simpl1 = algorithm::simplification::DouglasPeucker(bnd1,tolerance);
+	boundary::DiscreteBoundary<2>::Ptr simpl2 = algorithm::simplification::DouglasPeucker(bnd2,tolerance);
+
+	double distmax = HausDistSegmentsDirected(bnd1->getView(),SegmentBVH(simpl2));
+	
+	// symetric
+	distmax = std::max(distmax,HausDistSegmentsDirected(bnd2->getView(),SegmentBVH(simpl1)));
+
+	return distmax;
+}
+
+/**
+ *  \brief Directed early break Hausdorff distance
+ *
+ *  \param vert1   vertices from which the distance is computed
+ *  \param vert2   vertices to which the distance is computed
+ *  \param distmax current maximal squared distance, updated
+ */
+static void HausDistEarlyBreakDirected(const boundary::DiscreteBoundary<2>::VerticesView &vert1, const boundary::DiscreteBoundary<2>::VerticesView &vert2, std::atomic<double> &distmax)
+{
+#pragma omp parallel for schedule(dynamic,64)
+	for(unsigned int i = 0; i < vert1.size; i++)
 	{
-		double distcur = 0;
-		Eigen::Vector2d pt2 = bnd2->getVertex(j).getCoords();
-		for(unsigned int i = 0; i < bnd1->getNbVertices(); i++)
+		double distcmp = distmax.load(std::memory_order_relaxed);
+		// stops as soon as this vertex cannot increase the maximum anymore
+		double distcur = algorithm::evaluation::NearestSqDistAbove(Eigen::Vector2d(vert1.x[i],vert1.y[i]),vert2,distcmp);
+
+		while(distcur > distcmp && !distmax.compare_exchange_weak(distcmp,distcur,std::memory_order_relaxed));
+	}
+}
+
+/**
+ *  \brief Coordinates of the vertices of a boundary, in random order
+ *
+ *  \param bnd boundary
+ *  \param gen random generator
+ *  \param x   shuffled abscissas
+ *  \param y   shuffled ordinates
+ *
+ *  \return view on the shuffled coordinates
+ */
+static boundary::DiscreteBoundary<2>::VerticesView ShuffledVertices(const boundary::DiscreteBoundary<2>::Ptr bnd, std::mt19937 &gen, std::vector<double> &x, std::vector<double> &y)
+{
+	boundary::DiscreteBoundary<2>::VerticesView view = bnd->getView();
+	std::vector<unsigned int> order(view.size);
+	for(unsigned int i = 0; i < view.size; i++)
+		order[i] = i;
+	std::shuffle(order.begin(),order.end(),gen);
+
+	x.resize(view.size);
+	y.resize(view.size);
+	for(unsigned int i = 0; i < view.size; i++)
+	{
+		x[i] = view.x[order[i]];
+		y[i] = view.y[order[i]];
+	}
+	return boundary::DiscreteBoundary<2>::VerticesView{x.data(),y.data(),view.size};
+}
+
+double algorithm::evaluation::HausDistEarlyBreak(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2)
+{
+	if(bnd1->getNbVertices() == 0 && bnd2->getNbVertices() == 0)
+		return 0.0;
+	if(bnd1->getNbVertices() == 0 || bnd2->getNbVertices() == 0)
+		return std::numeric_limits<double>::infinity();
+
+	// random order makes the early break happen sooner
+	std::mt19937 gen(0);
+	std::vector<double> x1(0), y1(0), x2(0), y2(0);
+	boundary::DiscreteBoundary<2>::VerticesView vert1 = ShuffledVertices(bnd1,gen,x1,y1);
+	boundary::DiscreteBoundary<2>::VerticesView vert2 = ShuffledVertices(bnd2,gen,x2,y2);
+
+	std::atomic<double> distmax(0.0);
+	HausDistEarlyBreakDirected(vert1,vert2,distmax);
+	
+	// symetric
+	HausDistEarlyBreakDirected(vert2,vert1,distmax);
+
+	return std::sqrt(distmax.load());
+}
+
+double algorithm::evaluation::HausDist(const BoundaryGrid &grid1, const BoundaryGrid &grid2)
+{
+	if(grid1.getNbVertices() == 0 && grid2.getNbVertices() == 0)
+		return 0.0;
+	if(grid1.getNbVertices() == 0 || grid2.getNbVertices() == 0)
+		return std::numeric_limits<double>::infinity();
+
+	double distmax = 0.0;
+#pragma omp parallel
+	{
+		double distloc = 0.0;
+#pragma omp for nowait
+		for(unsigned int i = 0; i < grid1.getNbVertices(); i++)
+		{
+			double distcur = grid2.nearestSqDist(grid1.getCoordinates(i));
+			if(distcur > distloc)
+				distloc = distcur;
+		}
+		
+		// symetric
+#pragma omp for nowait
+		for(unsigned int j = 0; j < grid2.getNbVertices(); j++)
 		{
-			Eigen::Vector2d pt1 = bnd1->getVertex(i).getCoords();
-			double dist = (pt2 - pt1).squaredNorm();
-			if(dist < distcur || i == 0)
-				distcur = dist;
+			double distcur = grid1.nearestSqDist(grid2.getCoordinates(j));
+			if(distcur > distloc)
+				distloc = distcur;
 		}
 #pragma omp critical
 		{
-			if(distcur > distmax)
-				distmax = distcur;
+			if(distloc > distmax)
+				distmax = distloc;
 		}
 	}
 
-	return distmax;
+	return std::sqrt(distmax);
 }
 
-double algorithm::evaluation::HausDist(const skeleton::GraphSkel2d::Ptr grskl, const boundary::DiscreteBoundary<2>::Ptr disbnd, const mathtools::affine::Frame<2>::Ptr frame)
+algorithm::evaluation::SurfDistances algorithm::evaluation::SurfDist(const BoundaryGrid &grid1, const BoundaryGrid &grid2, const OptionsSurfDist &options)
 {
-	std::list<unsigned int> lnod;
-	std::list<mathtools::geometry::euclidian::HyperSphere<2> > lnodcir;
-	grskl->getAllNodes(lnod);
-	grskl->getNodes<mathtools::geometry::euclidian::HyperSphere<2>,std::list<unsigned int>,std::list<mathtools::geometry::euclidian::HyperSphere<2> > >(lnod,lnodcir);
-	double distmax = 0.0;
-#pragma omp parallel for
-	for(unsigned int i = 0; i < disbnd->getNbVertices(); i++)
+	if(options.binwidth <= 0.0)
+		throw std::logic_error("algorithm::evaluation::SurfDist : bin width has to be positive");
+	if(options.percentile < 0.0 || options.percentile > 100.0)
+		throw std::logic_error("algorithm::evaluation::SurfDist : percentile has to be in [0,100]");
+
+	if(grid1.getNbVertices() == 0 && grid2.getNbVertices() == 0)
+		return SurfDistances();
+	if(grid1.getNbVertices() == 0 || grid2.getNbVertices() == 0)
+		return SurfDistances(std::numeric_limits<double>::infinity(),std::numeric_limits<double>::infinity(),std::numeric_limits<double>::infinity());
+
+	// no distance can exceed the diagonal of both bounding boxes
+	Eigen::Vector2d ptmin = grid1.getLowerCorner().cwiseMin(grid2.getLowerCorner());
+	Eigen::Vector2d ptmax = grid1.getUpperCorner().cwiseMax(grid2.getUpperCorner());
+	unsigned int nbbins = (unsigned int)((ptmax - ptmin).norm() / options.binwidth) + 2;
+
+	std::vector<unsigned int> histcount(nbbins,0);
+	std::vector<double> histmax(nbbins,0.0);
+	double distmax = 0.0, distsum = 0.0;
+#pragma omp parallel
 	{
-		Eigen::Vector2d pt = disbnd->getVertex(i).getCoords();
-		double distcurmin = -1.0;
-		for(std::list<mathtools::geometry::euclidian::HyperSphere<2> >::iterator it = lnodcir.begin(); it != lnodcir.end() && distcurmin != 0.0; it++)
+		std::vector<unsigned int> loccount(nbbins,0);
+		std::vector<double> locmax(nbbins,0.0);
+		double distlocmax = 0.0, distlocsum = 0.0;
+
+		for(unsigned int k = 0; k < 2; k++)
 		{
-			Eigen::Vector2d ctr = it->getCenter().getCoords(frame);
-			
-			double distpt = (pt - ctr).norm();
-			
-			double distcur = 0.0;
-
-			if(distpt > it->getRadius())
-				distcur = distpt - it->getRadius();
-			
-			if(distcur < distcurmin || distcurmin == -1.0)
+			const BoundaryGrid &gridfrom = k == 0 ? grid1 : grid2;
+			const BoundaryGrid &gridto   = k == 0 ? grid2 : grid1;
+#pragma omp for nowait
+			for(unsigned int i = 0; i < gridfrom.getNbVertices(); i++)
 			{
-				distcurmin = distcur;
+				double dist = std::sqrt(gridto.nearestSqDist(gridfrom.getCoordinates(i)));
+				unsigned int bin = std::min((unsigned int)(dist / options.binwidth), nbbins-1);
+				loccount[bin]++;
+				if(dist > locmax[bin])
+					locmax[bin] = dist;
+				if(dist > distlocmax)
+					distlocmax = dist;
+				distlocsum += dist;
 			}
 		}
+
+#pragma omp critical
+		{
+			for(unsigned int b = 0; b < nbbins; b++)
+			{
+				histcount[b] += loccount[b];
+				if(locmax[b] > histmax[b])
+					histmax[b] = locmax[b];
+			}
+			if(distlocmax > distmax)
+				distmax = distlocmax;
+			distsum += distlocsum;
+		}
+	}
+
+	unsigned int nbvert = grid1.getNbVertices() + grid2.getNbVertices();
+	
+	// nearest rank of the percentile
+	unsigned int rank = (unsigned int)std::ceil(options.percentile / 100.0 * (double)nbvert);
+	rank = std::min(std::max(rank,1u),nbvert);
+	unsigned int cumul = 0, bin = 0;
+	for(bin = 0; bin < nbbins-1; bin++)
+	{
+		cumul += histcount[bin];
+		if(cumul >= rank)
+			break;
+	}
+
+	return SurfDistances(distmax,histmax[bin],distsum / (double)nbvert);
+}
+
+algorithm::evaluation::SurfDistances algorithm::evaluation::SurfDist(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2, const OptionsSurfDist &options)
+{
+	return SurfDist(BoundaryGrid(bnd1),BoundaryGrid(bnd2),options);
+}
+
+double algorithm::evaluation::HausDist(const DistanceMap &dismap1, const DistanceMap &dismap2)
+{
+	if(dismap1.getWidth() != dismap2.getWidth() || dismap1.getHeight() != dismap2.getHeight())
+		throw std::logic_error("algorithm::evaluation::HausDist : distance maps sizes differ");
+
+	const std::vector<std::size_t> &bnd1 = dismap1.getBoundary();
+	const std::vector<std::size_t> &bnd2 = dismap2.getBoundary();
+	if(bnd1.size() == 0 && bnd2.size() == 0)
+		return 0.0;
+	if(bnd1.size() == 0 || bnd2.size() == 0)
+		return std::numeric_limits<double>::infinity();
+
+	const std::vector<unsigned long long> &dist1 = dismap1.getContainer();
+	const std::vector<unsigned long long> &dist2 = dismap2.getContainer();
+
+	unsigned long long distmax = 0;
+	for(std::size_t i = 0; i < bnd1.size(); i++)
+		if(dist2[bnd1[i]] > distmax)
+			distmax = dist2[bnd1[i]];
+	
+	// symetric
+	for(std::size_t j = 0; j < bnd2.size(); j++)
+		if(dist1[bnd2[j]] > distmax)
+			distmax = dist1[bnd2[j]];
+
+	return std::sqrt((double)distmax);
+}
+
+double algorithm::evaluation::AvgSurfDist(const DistanceMap &dismap1, const DistanceMap &dismap2)
+{
+	if(dismap1.getWidth() != dismap2.getWidth() || dismap1.getHeight() != dismap2.getHeight())
+		throw std::logic_error("algorithm::evaluation::AvgSurfDist : distance maps sizes differ");
+
+	const std::vector<std::size_t> &bnd1 = dismap1.getBoundary();
+	const std::vector<std::size_t> &bnd2 = dismap2.getBoundary();
+	if(bnd1.size() == 0 && bnd2.size() == 0)
+		return 0.0;
+	if(bnd1.size() == 0 || bnd2.size() == 0)
+		return std::numeric_limits<double>::infinity();
+
+	const std::vector<unsigned long long> &dist1 = dismap1.getContainer();
+	const std::vector<unsigned long long> &dist2 = dismap2.getContainer();
+
+	double distsum = 0.0;
+#pragma omp parallel for reduction(+:distsum)
+	for(std::size_t i = 0; i < bnd1.size(); i++)
+		distsum += std::sqrt((double)dist2[bnd1[i]]);
+	
+	// symetric
+#pragma omp parallel for reduction(+:distsum)
+	for(std::size_t j = 0; j < bnd2.size(); j++)
+		distsum += std::sqrt((double)dist1[bnd2[j]]);
+
+	return distsum / (double)(bnd1.size() + bnd2.size());
+}
+
+double algorithm::evaluation::HausDistDT(const shape::DiscreteShape<2>::Ptr shpref, const shape::DiscreteShape<2>::Ptr shpcmp)
+{
+	return HausDist(DistanceMap(shpref),DistanceMap(shpcmp));
+}
+
+/**
+ *  \brief Builds a pyramid of boundary pixels
+ *
+ *  \param pixels   indices of the boundary pixels, row wise
+ *  \param width    width of the shape
+ *  \param height   height of the shape
+ *  \param coarsest maximal size of the coarsest level
+ *  \param pyramid  levels of the pyramid, finest first, each pixel set if one of its 2x2 children is
+ */
+static void BoundaryPyramid(const std::vector<std::size_t> &pixels, unsigned int width, unsigned int height, unsigned int coarsest, std::vector<shape::DiscreteShape<2>::Ptr> &pyramid)
+{
+	shape::DiscreteShape<2>::Ptr level(new shape::DiscreteShape<2>(width,height));
+	std::vector<unsigned char> &finest = level->getWritableContainer();
+	for(std::size_t i = 0; i < pixels.size(); i++)
+		finest[pixels[i]] = 255;
+	pyramid.push_back(level);
+
+	while(level->getWidth() > std::max(coarsest,1u) || level->getHeight() > std::max(coarsest,1u))
+	{
+		shape::DiscreteShape<2>::Ptr coarse(new shape::DiscreteShape<2>((level->getWidth()+1)/2,(level->getHeight()+1)/2));
+		const std::vector<unsigned char> &fine = level->getContainer();
+		std::vector<unsigned char> &disc = coarse->getWritableContainer();
+		for(unsigned int l = 0; l < level->getHeight(); l++)
+			for(unsigned int c = 0; c < level->getWidth(); c++)
+				if(fine[c + (std::size_t)level->getWidth() * l])
+					disc[c/2 + (std::size_t)coarse->getWidth() * (l/2)] = 255;
+		pyramid.push_back(coarse);
+		level = coarse;
+	}
+}
+
+/**
+ *  \brief Directed coarse to fine Hausdorff distance
+ *
+ *  \param pyramid pyramid of the boundary from which the distance is computed
+ *  \param grid    boundary pixels to which the distance is computed
+ *  \param lower   best lower bound of the Hausdorff distance, updated
+ *  \param epsilon tolerated gap between the lower and upper bounds
+ *
+ *  \return upper bound of the directed Hausdorff distance
+ */
+static double HausDistMultiResDirected(const std::vector<shape::DiscreteShape<2>::Ptr> &pyramid, const algorithm::evaluation::BoundaryGrid &grid, double &lower, double epsilon)
+{
+	struct Block
+	{
+		double upper;
+		unsigned int level, c, l;
+		bool operator<(const Block &block) const { return upper < block.upper; }
+	};
+
+	std::priority_queue<Block> queue;
+
+	// bounds of a block, from the exact distance of one of its pixels
+	auto pushBlock = [&](unsigned int level, unsigned int c, unsigned int l)
+	{
+		unsigned int cp = c, lp = l;
+		for(unsigned int k = level; k > 0; k--)
+		{
+			const shape::DiscreteShape<2> &fine = *pyramid[k-1];
+			const std::vector<unsigned char> &disc = fine.getContainer();
+			unsigned int cf = 2*cp, lf = 2*lp;
+			for(unsigned int i = 0; i < 4; i++)
+			{
+				unsigned int cc = cf + i%2, lc = lf + i/2;
+				if(cc < fine.getWidth() && lc < fine.getHeight() && disc[cc + (std::size_t)fine.getWidth() * lc])
+				{
+					cp = cc;
+					lp = lc;
+					break;
+				}
+			}
+		}
+
+		double dist = std::sqrt(grid.nearestSqDist(Eigen::Vector2d((double)cp,(double)lp)));
+		if(dist > lower)
+			lower = dist;
+		
+		// any pixel of the block is within its diagonal of the representative pixel
+		double diag = (double)((1u << level) - 1) * std::sqrt(2.0);
+		queue.push(Block{dist + diag,level,c,l});
+	};
+
+	const shape::DiscreteShape<2> &top = *pyramid.back();
+	const std::vector<unsigned char> &disctop = top.getContainer();
+	for(unsigned int l = 0; l < top.getHeight(); l++)
+		for(unsigned int c = 0; c < top.getWidth(); c++)
+			if(disctop[c + (std::size_t)top.getWidth() * l])
+				pushBlock(pyramid.size()-1,c,l);
+
+	while(queue.size() != 0)
+	{
+		Block block = queue.top();
+		if(block.upper <= lower + epsilon || block.level == 0)
+			break;
+		queue.pop();
+
+		const shape::DiscreteShape<2> &fine = *pyramid[block.level-1];
+		const std::vector<unsigned char> &disc = fine.getContainer();
+		for(unsigned int i = 0; i < 4; i++)
+		{
+			unsigned int cc = 2*block.c + i%2, lc = 2*block.l + i/2;
+			if(cc < fine.getWidth() && lc < fine.getHeight() && disc[cc + (std::size_t)fine.getWidth() * lc])
+				pushBlock(block.level-1,cc,lc);
+		}
+	}
+
+	double upper = lower;
+	if(queue.size() != 0 && queue.top().upper > upper)
+		upper = queue.top().upper;
+	return upper;
+}
+
+double algorithm::evaluation::HausDistMultiRes(const shape::DiscreteShape<2>::Ptr shpref, const shape::DiscreteShape<2>::Ptr shpcmp, double &upper, const OptionsMultiRes &options)
+{
+	if(shpref->getWidth() != shpcmp->getWidth() || shpref->getHeight() != shpcmp->getHeight())
+		throw std::logic_error("algorithm::evaluation::HausDistMultiRes : shapes sizes differ");
+
+	unsigned int width = shpref->getWidth();
+	std::vector<std::size_t> pixref(0), pixcmp(0);
+	BoundaryPixels(shpref,pixref);
+	BoundaryPixels(shpcmp,pixcmp);
+
+	upper = 0.0;
+	if(pixref.size() == 0 && pixcmp.size() == 0)
+		return 0.0;
+	if(pixref.size() == 0 || pixcmp.size() == 0)
+	{
+		upper = std::numeric_limits<double>::infinity();
+		return upper;
+	}
+
+	std::vector<Eigen::Vector2d> vecref(pixref.size()), veccmp(pixcmp.size());
+	for(std::size_t i = 0; i < pixref.size(); i++)
+		vecref[i] = Eigen::Vector2d((double)(pixref[i]%width),(double)(pixref[i]/width));
+	for(std::size_t i = 0; i < pixcmp.size(); i++)
+		veccmp[i] = Eigen::Vector2d((double)(pixcmp[i]%width),(double)(pixcmp[i]/width));
+
+	std::vector<shape::DiscreteShape<2>::Ptr> pyrref(0), pyrcmp(0);
+	BoundaryPyramid(pixref,width,shpref->getHeight(),options.coarsest,pyrref);
+	BoundaryPyramid(pixcmp,width,shpcmp->getHeight(),options.coarsest,pyrcmp);
+
+	double lower = 0.0;
+	double upperref = HausDistMultiResDirected(pyrref,BoundaryGrid(veccmp),lower,options.epsilon);
+	
+	// symetric
+	double uppercmp = HausDistMultiResDirected(pyrcmp,BoundaryGrid(vecref),lower,options.epsilon);
+
+	upper = std::max(lower,std::max(upperref,uppercmp));
+	return lower;
+}
+
+double algorithm::evaluation::HausDist(const skeleton::GraphSkel2d::Ptr grskl, const boundary::DiscreteBoundary<2>::Ptr disbnd, const mathtools::affine::Frame<2>::Ptr frame)
+{
+	DiskBVH bvh(grskl,frame);
+	double distmax = 0.0;
+#pragma omp parallel
+	{
+		double distloc = 0.0;
+#pragma omp for nowait
+		for(unsigned int i = 0; i < disbnd->getNbVertices(); i++)
+		{
+			double distcurmin = bvh.distance(disbnd->getCoordinates(i));
+			if(distcurmin > distloc)
+				distloc = distcurmin;
+		}
 #pragma omp critical
 		{
-			if(distcurmin > distmax)
-				distmax = distcurmin;
+			if(distloc > distmax)
+				distmax = distloc;
 		}
 	}
 	return distmax;
@@ -31,8 +31,15 @@ SOFTWARE.
 #define _SHAPEERROR_H_
 
 #include <shape/DiscreteShape.h>
+#include <shape/PackedShape.h>
+#include <shape/RLEShape.h>
 #include <boundary/DiscreteBoundary2.h>
 #include <skeleton/Skeletons.h>
+#include "BoundaryGrid.h"
+#include "DistanceMap.h"
+#include "DiskBVH.h"
+#include "DistanceKernels.h"
+#include "SegmentBVH.h"
 
 /**
  *  \brief Lots of algorithms
@@ -44,9 +51,358 @@ namespace algorithm
 	 */
 	namespace evaluation
 	{
+		/**
+		 *  \brief Hausdorff distance computation methods
+		 */
+		enum class HausDistMethod
+		{
+			automatic,
+			bruteforce,
+			indexed,
+			earlybreak
+		};
+
+		/**
+		 *  \brief Hausdorff distance options structure
+		 */
+		struct OptionsHausDist
+		{
+			/**
+			 *  \brief Computation method
+			 */
+			HausDistMethod method;
+
+			/**
+			 *  \brief Number of vertex pairs above which the automatic method uses the indexed computation
+			 */
+			double threshold;
+
+			/**
+			 *  \brief Default constructor
+			 */
+			OptionsHausDist(HausDistMethod method_ = HausDistMethod::automatic, double threshold_ = 1e5) :
+				method(method_), threshold(threshold_) {}
+		};
+
+		/**
+		 *  \brief Surface distances options structure
+		 */
+		struct OptionsSurfDist
+		{
+			/**
+			 *  \brief Percentile of the distances to compute, in [0,100]
+			 */
+			double percentile;
+
+			/**
+			 *  \brief Width of the histogram bins, bounding the percentile error
+			 */
+			double binwidth;
+
+			/**
+			 *  \brief Default constructor
+			 */
+			OptionsSurfDist(double percentile_ = 95.0, double binwidth_ = 0.1) :
+				percentile(percentile_), binwidth(binwidth_) {}
+		};
+
+		/**
+		 *  \brief Surface distances between two boundaries
+		 */
+		struct SurfDistances
+		{
+			/**
+			 *  \brief Hausdorff distance
+			 */
+			double hausdist;
+
+			/**
+			 *  \brief Percentile of the distances of each vertex to the other boundary (partial Hausdorff distance)
+			 */
+			double pcthausdist;
+
+			/**
+			 *  \brief Average symmetric surface distance
+			 */
+			double avgsurfdist;
+
+			/**
+			 *  \brief Default constructor
+			 */
+			SurfDistances(double hausdist_ = 0.0, double pcthausdist_ = 0.0, double avgsurfdist_ = 0.0) :
+				hausdist(hausdist_), pcthausdist(pcthausdist_), avgsurfdist(avgsurfdist_) {}
+		};
+
+		/**
+		 *  \brief Details of a Hausdorff distance between two boundaries
+		 */
+		struct HausDistDetails
+		{
+			/**
+			 *  \brief Hausdorff distance
+			 */
+			double hausdist;
+
+			/**
+			 *  \brief Index of the witness vertex in the first boundary
+			 */
+			unsigned int index1;
+
+			/**
+			 *  \brief Index of the witness vertex in the second boundary
+			 */
+			unsigned int index2;
+
+			/**
+			 *  \brief Coordinates of the witness vertex in the first boundary
+			 */
+			Eigen::Vector2d point1;
+
+			/**
+			 *  \brief Coordinates of the witness vertex in the second boundary
+			 */
+			Eigen::Vector2d point2;
+
+			/**
+			 *  \brief Distance of each vertex of the first boundary to the second one (empty if not requested)
+			 */
+			std::vector<double> dist1;
+
+			/**
+			 *  \brief Distance of each vertex of the second boundary to the first one (empty if not requested)
+			 */
+			std::vector<double> dist2;
+
+			/**
+			 *  \brief Default constructor
+			 */
+			HausDistDetails() :
+				hausdist(0.0), index1(0), index2(0), point1(0.0,0.0), point2(0.0,0.0), dist1(0), dist2(0) {}
+		};
+
+		/**
+		 *  \brief Multiresolution Hausdorff distance options structure
+		 */
+		struct OptionsMultiRes
+		{
+			/**
+			 *  \brief Tolerated gap between the returned distance and its upper bound (0 for the exact distance)
+			 */
+			double epsilon;
+
+			/**
+			 *  \brief Maximal width and height of the coarsest level of the pyramid
+			 */
+			unsigned int coarsest;
+
+			/**
+			 *  \brief Default constructor
+			 */
+			OptionsMultiRes(double epsilon_ = 0.0, unsigned int coarsest_ = 16) :
+				epsilon(epsilon_), coarsest(coarsest_) {}
+		};
+
 		double SymDiffArea(const shape::DiscreteShape<2>::Ptr shpref, const shape::DiscreteShape<2>::Ptr shpcmp);
 
-		double HausDist(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2);
+		/**
+		 *  \brief Computes the symmetric difference area between two bit packed shapes, relative to the reference area
+		 *
+		 *  \details Single pass of xor and population count over the words of both shapes
+		 *
+		 *  \param shpref reference shape
+		 *  \param shpcmp compared shape
+		 *
+		 *  \return symmetric difference area divided by the area of the reference
+		 */
+		double SymDiffArea(const shape::PackedShape<2>::Ptr shpref, const shape::PackedShape<2>::Ptr shpcmp);
+
+		/**
+		 *  \brief Computes the symmetric difference area between two run length encoded shapes, relative to the reference area
+		 *
+		 *  \details Runs of each row are intersected, in time proportional to the number of runs
+		 *
+		 *  \param shpref reference shape
+		 *  \param shpcmp compared shape
+		 *
+		 *  \return symmetric difference area divided by the area of the reference
+		 */
+		double SymDiffArea(const shape::RLEShape<2>::Ptr shpref, const shape::RLEShape<2>::Ptr shpcmp);
+
+		/**
+		 *  \brief Computes the Hausdorff distance between two boundaries
+		 *
+		 *  \param bnd1    first boundary
+		 *  \param bnd2    second boundary
+		 *  \param options computation options
+		 *
+		 *  \return Hausdorff distance between the vertices of the boundaries (infinite if only one boundary is empty)
+		 */
+		double HausDist(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2, const OptionsHausDist &options = OptionsHausDist());
+
+		/**
+		 *  \brief Computes the Hausdorff distance between two boundaries, and where it is reached
+		 *
+		 *  \details The witness is the pair of vertices at Hausdorff distance, one being the nearest
+		 *           vertex of the other. Everything is computed in the same indexed pass.
+		 *
+		 *  \param bnd1      first boundary
+		 *  \param bnd2      second boundary
+		 *  \param details   Hausdorff distance, witness, and distances of each vertex
+		 *  \param pervertex true to fill the distances of each vertex
+		 *
+		 *  \return Hausdorff distance between the vertices of the boundaries (infinite if only one boundary is empty)
+		 */
+		double HausDist(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2, HausDistDetails &details, bool pervertex = false);
+
+		/**
+		 *  \brief Computes the Hausdorff distance between two boundaries, comparing all pairs of vertices
+		 *
+		 *  \param bnd1 first boundary
+		 *  \param bnd2 second boundary
+		 *
+		 *  \return Hausdorff distance between the vertices of the boundaries (infinite if only one boundary is empty)
+		 */
+		double HausDistBruteForce(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2);
+
+		/**
+		 *  \brief Computes the Hausdorff distance between the vertices of each boundary and the segments of the other one
+		 *
+		 *  \details Segments link each vertex to the next one in its loop, every vertex is compared to every segment
+		 *
+		 *  \param bnd1 first boundary
+		 *  \param bnd2 second boundary
+		 *
+		 *  \return Hausdorff distance between vertices and segments (infinite if only one boundary is empty)
+		 */
+		double HausDistSegmentsBruteForce(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2);
+
+		/**
+		 *  \brief Computes the Hausdorff distance between the vertices of each boundary and the segments of the other one
+		 *
+		 *  \details Segments link each vertex to the next one in its loop, and are indexed in a bounding volume hierarchy
+		 *
+		 *  \param bnd1 first boundary
+		 *  \param bnd2 second boundary
+		 *
+		 *  \return Hausdorff distance between vertices and segments (infinite if only one boundary is empty)
+		 */
+		double HausDistSegments(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2);
+
+		/**
+		 *  \brief Approximates the vertices to segments Hausdorff distance, on simplified boundaries
+		 *
+		 *  \details Both boundaries are simplified with Douglas-Peucker, within tolerance. Distances are
+		 *           computed from every vertex of each boundary to the segments of the other simplified one:
+		 *           the number of queries is the one of HausDistSegments, only the indexed segments are fewer,
+		 *           which makes each query shallower. Querying the simplified vertices instead would not bound
+		 *           the error, since the distance to the other boundary may peak between two kept vertices.
+		 *
+		 *  \param bnd1      first boundary
+		 *  \param bnd2      second boundary
+		 *  \param tolerance maximal deviation of the simplified boundaries
+		 *
+		 *  \return Hausdorff distance, at most at tolerance from HausDistSegments(bnd1,bnd2) (infinite if only one boundary is empty)
+		 */
+		double HausDistSimplified(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2, double tolerance);
+
+		/**
+		 *  \brief Computes the Hausdorff distance between two boundaries, with the early break scheme
+		 *
+		 *  \details Vertices are visited in random order, and the search of the nearest vertex stops as
+		 *           soon as it gets under the current maximum, shared between threads (Taha and Hanbury)
+		 *
+		 *  \param bnd1 first boundary
+		 *  \param bnd2 second boundary
+		 *
+		 *  \return Hausdorff distance between the vertices of the boundaries (infinite if only one boundary is empty)
+		 */
+		double HausDistEarlyBreak(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2);
+
+		/**
+		 *  \brief Computes the Hausdorff distance between two indexed sets of vertices
+		 *
+		 *  \param grid1 first indexed set of vertices
+		 *  \param grid2 second indexed set of vertices
+		 *
+		 *  \return Hausdorff distance between the vertices (infinite if only one set is empty)
+		 */
+		double HausDist(const BoundaryGrid &grid1, const BoundaryGrid &grid2);
+
+		/**
+		 *  \brief Computes Hausdorff, partial Hausdorff and average surface distances between two indexed sets of vertices
+		 *
+		 *  \details The distances of the vertices of both sets to the other set are accumulated in per thread
+		 *           histograms during the nearest vertex queries. The percentile is taken on both sets together,
+		 *           as the largest distance of its bin, which is at most one bin width above the exact value.
+		 *           Throws if the bin width is not positive or the percentile is not in [0,100].
+		 *
+		 *  \param grid1   first indexed set of vertices
+		 *  \param grid2   second indexed set of vertices
+		 *  \param options computation options
+		 *
+		 *  \return surface distances between the vertices (infinite if only one set is empty)
+		 */
+		SurfDistances SurfDist(const BoundaryGrid &grid1, const BoundaryGrid &grid2, const OptionsSurfDist &options = OptionsSurfDist());
+
+		/**
+		 *  \brief Computes Hausdorff, partial Hausdorff and average surface distances between two boundaries
+		 *
+		 *  \param bnd1    first boundary
+		 *  \param bnd2    second boundary
+		 *  \param options computation options
+		 *
+		 *  \return surface distances between the vertices of the boundaries
+		 */
+		SurfDistances SurfDist(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2, const OptionsSurfDist &options = OptionsSurfDist());
+
+		/**
+		 *  \brief Computes the Hausdorff distance between the boundary pixels of two shapes
+		 *
+		 *  \details Each boundary is read in the distance map of the other one
+		 *
+		 *  \param dismap1 distance map of the first shape
+		 *  \param dismap2 distance map of the second shape
+		 *
+		 *  \return Hausdorff distance between the boundary pixels (infinite if only one boundary is empty)
+		 */
+		double HausDist(const DistanceMap &dismap1, const DistanceMap &dismap2);
+
+		/**
+		 *  \brief Computes the average symmetric surface distance between the boundary pixels of two shapes
+		 *
+		 *  \param dismap1 distance map of the first shape
+		 *  \param dismap2 distance map of the second shape
+		 *
+		 *  \return average distance of each boundary pixel to the other boundary (infinite if only one boundary is empty)
+		 */
+		double AvgSurfDist(const DistanceMap &dismap1, const DistanceMap &dismap2);
+
+		/**
+		 *  \brief Computes the Hausdorff distance between the boundary pixels of two shapes, coarse to fine
+		 *
+		 *  \details Boundary pixels are summed up in pyramids of downsampled shapes. Each block of the pyramid
+		 *           gets lower and upper bounds of the distance of its pixels to the other boundary, from
+		 *           the exact distance of one of its pixels. Only the blocks whose upper bound exceeds the
+		 *           best lower bound (plus epsilon) are refined.
+		 *
+		 *  \param shpref  reference shape
+		 *  \param shpcmp  compared shape
+		 *  \param upper   certified upper bound of the Hausdorff distance
+		 *  \param options computation options
+		 *
+		 *  \return Hausdorff distance between the boundary pixels, certified lower bound within epsilon of the upper bound
+		 */
+		double HausDistMultiRes(const shape::DiscreteShape<2>::Ptr shpref, const shape::DiscreteShape<2>::Ptr shpcmp, double &upper, const OptionsMultiRes &options = OptionsMultiRes());
+
+		/**
+		 *  \brief Computes the Hausdorff distance between the boundary pixels of two shapes, with distance transforms
+		 *
+		 *  \param shpref reference shape
+		 *  \param shpcmp compared shape
+		 *
+		 *  \return Hausdorff distance between the boundary pixels
+		 */
+		double HausDistDT(const shape::DiscreteShape<2>::Ptr shpref, const shape::DiscreteShape<2>::Ptr shpcmp);
 
 		double HausDist(const skeleton::GraphSkel2d::Ptr grskl, const boundary::DiscreteBoundary<2>::Ptr disbnd, const mathtools::affine::Frame<2>::Ptr frame);
 	}
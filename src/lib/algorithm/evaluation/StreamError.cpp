@@ -0,0 +1,444 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file StreamError.cpp
+ *  \brief Computes the error between two shapes read as row streams
+ *  \author Bastien Durix
+ */
+
+#include "StreamError.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ *  \brief Finds the crack boundary vertices on a line of pixel corners
+ *
+ *  \details Corner (c,l) is a boundary vertex when the four pixels around it are not all equal
+ *
+ *  \param prev   row above the corners (row l-1)
+ *  \param cur    row below the corners (row l)
+ *  \param width  width of the rows
+ *  \param corner flags of the width+1 corners of the line, set on the boundary vertices
+ */
+static void CornerLine(const unsigned char *prev, const unsigned char *cur, unsigned int width, unsigned char *corner)
+{
+	bool tl = false, bl = false;
+	for(unsigned int c = 0; c <= width; c++)
+	{
+		bool tr = c < width && prev[c] != 0;
+		bool br = c < width && cur[c] != 0;
+		corner[c] = !(tl == tr && tl == bl && tl == br);
+		tl = tr;
+		bl = br;
+	}
+}
+
+/**
+ *  \brief Directed Hausdorff distance between two sets of boundary vertices, read corners line by corners line
+ *
+ *  \details Only distance state is kept between the lines:
+ *           - for each column, the last line holding a target vertex, from which the distance of a new source
+ *             vertex to the targets above it is computed exactly (lower envelope of parabolas, as in Meijster's
+ *             distance transform),
+ *           - for each column, the source vertices whose distance could still decrease with the next lines.
+ *           A source vertex is final as soon as its distance is at most its gap to the next line. Among the
+ *           pending vertices of a column, a lower vertex whose distance does not exceed the one of a higher
+ *           vertex can never give the maximum, and is dropped: the pending distances of a column increase
+ *           strictly downwards, which leaves a few vertices per column in practice.
+ *           Distances are squared integers, so that the result is exactly the one of the whole sets.
+ */
+class DirectedStreamDist
+{
+	protected:
+		/**
+		 *  \brief Source vertex whose distance may still decrease
+		 */
+		struct Pending
+		{
+			/**
+			 *  \brief Corners line of the vertex
+			 */
+			unsigned int line;
+
+			/**
+			 *  \brief Squared distance to the target vertices read so far
+			 */
+			long long sqdist;
+		};
+
+		/**
+		 *  \brief Number of corners per line
+		 */
+		unsigned int m_nbcorners;
+
+		/**
+		 *  \brief Vertical gap standing for a column without target vertex, larger than any distance
+		 */
+		long long m_infgap;
+
+		/**
+		 *  \brief Last line holding a target vertex plus one, per column (0 if there is none)
+		 */
+		std::vector<unsigned int> m_last;
+
+		/**
+		 *  \brief Pending source vertices of each column, from top to bottom
+		 */
+		std::vector<std::vector<Pending> > m_pending;
+
+		/**
+		 *  \brief Squared distances of the current line to the targets above it, or to the targets of the line
+		 */
+		std::vector<long long> m_dist;
+
+		/**
+		 *  \brief Parabolas of the lower envelope (Meijster's s)
+		 */
+		std::vector<unsigned int> m_parab;
+
+		/**
+		 *  \brief Starts of the parabolas in the lower envelope (Meijster's t)
+		 */
+		std::vector<unsigned int> m_start;
+
+		/**
+		 *  \brief Maximal squared distance of the final source vertices
+		 */
+		long long m_max;
+
+		/**
+		 *  \brief True if a source vertex has been read
+		 */
+		bool m_source;
+
+		/**
+		 *  \brief True if a target vertex has been read
+		 */
+		bool m_target;
+
+		/**
+		 *  \brief Vertical gap between a line and the last target vertex of a column
+		 *
+		 *  \param c column
+		 *  \param l current line
+		 *
+		 *  \return gap, m_infgap if the column has no target vertex yet
+		 */
+		long long gap(unsigned int c, unsigned int l) const
+		{
+			return m_last[c] ? (long long)(l + 1 - m_last[c]) : m_infgap;
+		}
+
+		/**
+		 *  \brief Squared distances of the line corners to the target vertices above them or on the line
+		 *
+		 *  \param l current line, already recorded in m_last
+		 */
+		void upwardDist(unsigned int l)
+		{
+			auto f = [this,l](long long x, unsigned int i){ long long g = gap(i,l); return (x - (long long)i)*(x - (long long)i) + g*g; };
+
+			int q = 0;
+			m_parab[0] = 0;
+			m_start[0] = 0;
+			for(unsigned int u = 1; u < m_nbcorners; u++)
+			{
+				while(q >= 0 && f(m_start[q],m_parab[q]) > f(m_start[q],u))
+					q--;
+				if(q < 0)
+				{
+					q = 0;
+					m_parab[0] = u;
+				}
+				else
+				{
+					long long gi = gap(m_parab[q],l), gu = gap(u,l);
+					long long i = m_parab[q];
+					long long w = 1 + ((long long)u*u - i*i + gu*gu - gi*gi) / (2*((long long)u - i));
+					if(w < (long long)m_nbcorners)
+					{
+						q++;
+						m_parab[q] = u;
+						m_start[q] = (unsigned int)w;
+					}
+				}
+			}
+			for(unsigned int u = m_nbcorners; u-- > 0;)
+			{
+				m_dist[u] = f(u,m_parab[q]);
+				if(u == m_start[q])
+					q--;
+			}
+		}
+
+	public:
+		/**
+		 *  \brief Constructor
+		 *
+		 *  \param nbcorners number of corners per line
+		 *  \param nblines   number of corners lines
+		 */
+		DirectedStreamDist(unsigned int nbcorners, unsigned int nblines) :
+			m_nbcorners(nbcorners), m_infgap((long long)nbcorners + nblines + 1), m_last(nbcorners,0), m_pending(nbcorners),
+			m_dist(nbcorners,0), m_parab(nbcorners,0), m_start(nbcorners,0), m_max(0), m_source(false), m_target(false)
+		{}
+
+		/**
+		 *  \brief Reads the next corners line
+		 *
+		 *  \param source flags of the source vertices of the line
+		 *  \param target flags of the target vertices of the line
+		 *  \param l      index of the line
+		 */
+		void addLine(const unsigned char *source, const unsigned char *target, unsigned int l)
+		{
+			bool anysource = false, anytarget = false;
+			for(unsigned int c = 0; c < m_nbcorners; c++)
+			{
+				anysource = anysource || source[c];
+				if(target[c])
+				{
+					m_last[c] = l + 1;
+					anytarget = true;
+				}
+			}
+			m_source = m_source || anysource;
+			m_target = m_target || anytarget;
+
+			// pending vertices get closer to the targets of this line
+			if(anytarget)
+			{
+				long long near = m_infgap;
+				for(unsigned int c = 0; c < m_nbcorners; c++)
+				{
+					near = target[c] ? 0 : std::min(near + 1, m_infgap);
+					m_dist[c] = near;
+				}
+				near = m_infgap;
+				for(unsigned int c = m_nbcorners; c-- > 0;)
+				{
+					near = target[c] ? 0 : std::min(near + 1, m_infgap);
+					m_dist[c] = std::min(m_dist[c], near);
+				}
+				for(unsigned int c = 0; c < m_nbcorners; c++)
+					for(Pending &pend : m_pending[c])
+					{
+						long long dy = (long long)(l - pend.line);
+						pend.sqdist = std::min(pend.sqdist, m_dist[c] * m_dist[c] + dy * dy);
+					}
+			}
+
+			// final and dominated pending vertices
+			for(unsigned int c = 0; c < m_nbcorners; c++)
+			{
+				std::vector<Pending> &pending = m_pending[c];
+				if(pending.size() == 0)
+					continue;
+				long long above = -1;
+				unsigned int nbkept = 0;
+				for(unsigned int k = 0; k < pending.size(); k++)
+				{
+					long long dy = (long long)(l + 1 - pending[k].line);
+					if(pending[k].sqdist <= above)
+						continue;
+					above = pending[k].sqdist;
+					if(pending[k].sqdist <= dy * dy)
+						m_max = std::max(m_max, pending[k].sqdist);
+					else
+						pending[nbkept++] = pending[k];
+				}
+				pending.resize(nbkept);
+			}
+
+			// source vertices of this line, distance to the targets above them
+			if(anysource)
+			{
+				upwardDist(l);
+				for(unsigned int c = 0; c < m_nbcorners; c++)
+				{
+					if(!source[c])
+						continue;
+					if(m_dist[c] <= 1)
+						m_max = std::max(m_max, m_dist[c]);
+					else if(m_pending[c].size() == 0 || m_pending[c].back().sqdist < m_dist[c])
+						m_pending[c].push_back(Pending{l,m_dist[c]});
+				}
+			}
+		}
+
+		/**
+		 *  \brief Ends the reading, the pending vertices are final
+		 *
+		 *  \return squared directed Hausdorff distance, 0 if there is no source or no target vertex
+		 */
+		long long finish()
+		{
+			for(unsigned int c = 0; c < m_nbcorners; c++)
+			{
+				for(const Pending &pend : m_pending[c])
+					m_max = std::max(m_max, pend.sqdist);
+				std::vector<Pending>().swap(m_pending[c]);
+			}
+			return m_source && m_target ? m_max : 0;
+		}
+
+		/**
+		 *  \brief Source getter
+		 *
+		 *  \return true if a source vertex has been read
+		 */
+		bool hasSource() const
+		{
+			return m_source;
+		}
+};
+
+/**
+ *  \brief Reads two streams band by band, counting areas and computing the Hausdorff distance
+ *
+ *  \param shpref   reference shape stream
+ *  \param shpcmp   compared shape stream
+ *  \param options  evaluation options
+ *  \param bnd      true to compute the Hausdorff distance
+ *  \param areadiff symmetric difference area
+ *  \param arearef  reference area
+ *  \param hausdist Hausdorff distance between the crack boundaries
+ */
+static void ScanStreams(shape::RowStream &shpref, shape::RowStream &shpcmp, const algorithm::evaluation::OptionsStream &options, bool bnd,
+						unsigned long long &areadiff, unsigned long long &arearef, double &hausdist)
+{
+	if(shpref.getWidth() != shpcmp.getWidth() || shpref.getHeight() != shpcmp.getHeight())
+		throw std::logic_error("algorithm::evaluation::StreamError : shapes sizes differ");
+	if(options.bandheight == 0)
+		throw std::logic_error("algorithm::evaluation::StreamError : band height has to be positive");
+
+	const unsigned int width = shpref.getWidth();
+	const unsigned int height = shpref.getHeight();
+	const unsigned int bandheight = std::min(options.bandheight, std::max(height, 1u));
+
+	// first row of each window is the last row of the previous band (empty above the shape)
+	std::vector<unsigned char> winref((std::size_t)(bandheight + 1) * width, 0);
+	std::vector<unsigned char> wincmp((std::size_t)(bandheight + 1) * width, 0);
+	std::vector<unsigned char> cornref(bnd ? (std::size_t)bandheight * (width + 1) : 0), corncmp(bnd ? (std::size_t)bandheight * (width + 1) : 0);
+	DirectedStreamDist distref(bnd ? width + 1 : 0, height + 1), distcmp(bnd ? width + 1 : 0, height + 1);
+
+	areadiff = 0;
+	arearef = 0;
+	for(unsigned int lbeg = 0; lbeg < height; lbeg += bandheight)
+	{
+		const unsigned int nbrows = std::min(bandheight, height - lbeg);
+		for(unsigned int i = 1; i <= nbrows; i++)
+		{
+			shpref.readRow(winref.data() + (std::size_t)width * i);
+			shpcmp.readRow(wincmp.data() + (std::size_t)width * i);
+		}
+
+		unsigned long long banddiff = 0, bandref = 0;
+#pragma omp parallel for reduction(+:banddiff,bandref)
+		for(unsigned int i = 1; i <= nbrows; i++)
+		{
+			const unsigned char *rowref = winref.data() + (std::size_t)width * i;
+			const unsigned char *rowcmp = wincmp.data() + (std::size_t)width * i;
+			for(unsigned int c = 0; c < width; c++)
+			{
+				banddiff += (rowref[c] != 0) != (rowcmp[c] != 0);
+				bandref  += rowref[c] != 0;
+			}
+
+			if(bnd)
+			{
+				CornerLine(rowref - width,rowref,width,cornref.data() + (std::size_t)(width + 1) * (i-1));
+				CornerLine(rowcmp - width,rowcmp,width,corncmp.data() + (std::size_t)(width + 1) * (i-1));
+			}
+		}
+		areadiff += banddiff;
+		arearef  += bandref;
+
+		if(bnd)
+		{
+			// lines are read in order, one direction per thread
+#pragma omp parallel for
+			for(unsigned int k = 0; k < 2; k++)
+			{
+				DirectedStreamDist &dist = k == 0 ? distref : distcmp;
+				const std::vector<unsigned char> &source = k == 0 ? cornref : corncmp;
+				const std::vector<unsigned char> &target = k == 0 ? corncmp : cornref;
+				for(unsigned int i = 0; i < nbrows; i++)
+					dist.addLine(source.data() + (std::size_t)(width + 1) * i,target.data() + (std::size_t)(width + 1) * i,lbeg + i);
+			}
+		}
+
+		std::copy(winref.begin() + (std::size_t)width * nbrows, winref.begin() + (std::size_t)width * (nbrows + 1), winref.begin());
+		std::copy(wincmp.begin() + (std::size_t)width * nbrows, wincmp.begin() + (std::size_t)width * (nbrows + 1), wincmp.begin());
+	}
+
+	if(bnd)
+	{
+		if(height != 0)
+		{
+			// last corners line, below the shape
+			std::fill(winref.begin() + width, winref.begin() + 2 * (std::size_t)width, 0);
+			std::fill(wincmp.begin() + width, wincmp.begin() + 2 * (std::size_t)width, 0);
+			CornerLine(winref.data(),winref.data() + width,width,cornref.data());
+			CornerLine(wincmp.data(),wincmp.data() + width,width,corncmp.data());
+			distref.addLine(cornref.data(),corncmp.data(),height);
+			distcmp.addLine(corncmp.data(),cornref.data(),height);
+		}
+
+		bool hasref = distref.hasSource(), hascmp = distcmp.hasSource();
+		long long sqdist = std::max(distref.finish(),distcmp.finish());
+		if(!hasref && !hascmp)
+			hausdist = 0.0;
+		else if(!hasref || !hascmp)
+			hausdist = std::numeric_limits<double>::infinity();
+		else
+			hausdist = std::sqrt((double)sqdist);
+	}
+}
+
+algorithm::evaluation::StreamErrors algorithm::evaluation::StreamError(const shape::RowStream::Ptr shpref, const shape::RowStream::Ptr shpcmp, const OptionsStream &options)
+{
+	unsigned long long areadiff, arearef;
+	StreamErrors err;
+	ScanStreams(*shpref,*shpcmp,options,true,areadiff,arearef,err.hausdist);
+
+	err.symdiff = (double)areadiff/(double)arearef;
+	return err;
+}
+
+double algorithm::evaluation::SymDiffArea(const shape::RowStream::Ptr shpref, const shape::RowStream::Ptr shpcmp, const OptionsStream &options)
+{
+	unsigned long long areadiff, arearef;
+	double hausdist;
+	ScanStreams(*shpref,*shpcmp,options,false,areadiff,arearef,hausdist);
+
+	return (double)areadiff/(double)arearef;
+}
+
+double algorithm::evaluation::HausDist(const shape::RowStream::Ptr shpref, const shape::RowStream::Ptr shpcmp, const OptionsStream &options)
+{
+	return StreamError(shpref,shpcmp,options).hausdist;
+}
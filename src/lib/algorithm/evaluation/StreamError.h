@@ -0,0 +1,126 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file StreamError.h
+ *  \brief Computes the error between two shapes read as row streams
+ *  \author Bastien Durix
+ */
+
+#ifndef _STREAMERROR_H_
+#define _STREAMERROR_H_
+
+#include <shape/RowStream.h>
+
+/**
+ *  \brief Lots of algorithms
+ */
+namespace algorithm
+{
+	/**
+	 *  \brief Evaluation algorithms
+	 */
+	namespace evaluation
+	{
+		/**
+		 *  \brief Stream evaluation options structure
+		 */
+		struct OptionsStream
+		{
+			/**
+			 *  \brief Number of rows read from each stream at once
+			 */
+			unsigned int bandheight;
+
+			/**
+			 *  \brief Default constructor
+			 */
+			OptionsStream(unsigned int bandheight_ = 256) :
+				bandheight(bandheight_) {}
+		};
+
+		/**
+		 *  \brief Errors between two streamed shapes
+		 */
+		struct StreamErrors
+		{
+			/**
+			 *  \brief Symmetric difference area, relative to the reference area
+			 */
+			double symdiff;
+
+			/**
+			 *  \brief Hausdorff distance between the crack boundaries (infinite if only one shape is empty)
+			 */
+			double hausdist;
+
+			/**
+			 *  \brief Default constructor
+			 */
+			StreamErrors() :
+				symdiff(0.0), hausdist(0.0) {}
+		};
+
+		/**
+		 *  \brief Computes the symmetric difference area and the Hausdorff distance between two streamed shapes
+		 *
+		 *  \details Both streams are read band by band, in a single pass. Only the current bands and the last
+		 *           row of the previous ones are kept, to find the crack boundary vertices on the band edges.
+		 *           The Hausdorff distance is updated line by line from per column state,
+		 *           so that peak memory is the band size plus a few pending vertices per column.
+		 *
+		 *  \param shpref  reference shape stream
+		 *  \param shpcmp  compared shape stream
+		 *  \param options evaluation options
+		 *
+		 *  \return symmetric difference area and Hausdorff distance, as with a BorderFollowing boundary
+		 */
+		StreamErrors StreamError(const shape::RowStream::Ptr shpref, const shape::RowStream::Ptr shpcmp, const OptionsStream &options = OptionsStream());
+
+		/**
+		 *  \brief Computes the symmetric difference area between two streamed shapes, relative to the reference area
+		 *
+		 *  \details Only one band of each stream is held in memory
+		 *
+		 *  \param shpref  reference shape stream
+		 *  \param shpcmp  compared shape stream
+		 *  \param options evaluation options
+		 *
+		 *  \return symmetric difference area divided by the area of the reference
+		 */
+		double SymDiffArea(const shape::RowStream::Ptr shpref, const shape::RowStream::Ptr shpcmp, const OptionsStream &options = OptionsStream());
+
+		/**
+		 *  \brief Computes the Hausdorff distance between the crack boundaries of two streamed shapes
+		 *
+		 *  \param shpref  reference shape stream
+		 *  \param shpcmp  compared shape stream
+		 *  \param options evaluation options
+		 *
+		 *  \return Hausdorff distance between the boundary vertices (infinite if only one shape is empty)
+		 */
+		double HausDist(const shape::RowStream::Ptr shpref, const shape::RowStream::Ptr shpcmp, const OptionsStream &options = OptionsStream());
+	}
+}
+
+#endif //_STREAMERROR_H_
@@ -0,0 +1,545 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file BorderFollowing.cpp
+ *  \brief Extracts a boundary by following the borders in one raster scan
+ *  \author Bastien Durix
+ */
+
+#include "BorderFollowing.h"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+/**
+ *  \brief Border directions, from a pixel corner: right, down, left, up
+ */
+static const int dircol[4] = {1,0,-1,0};
+static const int dirlin[4] = {0,1,0,-1};
+
+/**
+ *  \brief Outgoing border directions at a pixel corner
+ *
+ *  \tparam Pixel pixel accessor, returning false outside of the shape
+ *
+ *  \param pixel pixel accessor
+ *  \param c     column of the corner
+ *  \param l     line of the corner
+ *
+ *  \return mask of the outgoing directions (bit d for direction d)
+ */
+template<typename Pixel>
+static inline unsigned char OutDirections(const Pixel &pixel, int c, int l)
+{
+	bool tl = pixel(c-1,l-1);
+	bool tr = pixel(c  ,l-1);
+	bool bl = pixel(c-1,l  );
+	bool br = pixel(c  ,l  );
+	
+	// the shape is kept on the right of the borders
+	return (unsigned char)((( br && !tr) ? 1 : 0) |
+	                       (( bl && !br) ? 2 : 0) |
+	                       (( tl && !bl) ? 4 : 0) |
+	                       (( tr && !tl) ? 8 : 0));
+}
+
+/**
+ *  \brief Direction of the border leaving a pixel corner
+ *
+ *  \tparam Pixel pixel accessor, returning false outside of the shape
+ *
+ *  \param pixel pixel accessor
+ *  \param c     column of the corner
+ *  \param l     line of the corner
+ *  \param d     direction of the border reaching the corner
+ *
+ *  \return direction of the next border
+ */
+template<typename Pixel>
+static inline unsigned int NextDirection(const Pixel &pixel, int c, int l, unsigned int d)
+{
+	unsigned char out = OutDirections(pixel,c,l);
+	if(out & (1 << ((d+1)%4)))
+		return (d+1)%4; // saddle corners: turn right
+	for(d = 0; !(out & (1 << d)); d++);
+	return d;
+}
+
+/**
+ *  \brief Borders followed in a band of lines
+ */
+struct BandBorders
+{
+	/**
+	 *  \brief Corners of the chains, one after the other
+	 */
+	std::vector<unsigned int> vertices;
+
+	/**
+	 *  \brief First corner of each chain in vertices (plus the end)
+	 */
+	std::vector<unsigned int> offset;
+
+	/**
+	 *  \brief First border of each chain (corner * 4 + direction)
+	 */
+	std::vector<uint64_t> begin;
+
+	/**
+	 *  \brief Border following each chain, equal to begin for closed loops
+	 */
+	std::vector<uint64_t> end;
+
+	BandBorders() : vertices(0), offset(1,0), begin(0), end(0) {}
+};
+
+/**
+ *  \brief Follows the borders leaving the corners of a band of lines
+ *
+ *  \details Chains entering the band from its seams are followed first, then the corners are scanned
+ *           row wise: borders met for the first time belong to loops lying in the band, and the
+ *           corner is their first one. Followed borders are stored per line.
+ *
+ *  \tparam Pixel   pixel accessor, returning false outside of the shape
+ *  \tparam Corners corners enumerator, visiting in order the corners of a line which may have borders
+ *
+ *  \param pixel   pixel accessor
+ *  \param corners corners enumerator
+ *  \param width   width of the shape
+ *  \param height  height of the shape
+ *  \param lbeg    first line of corners of the band
+ *  \param lend    line of corners after the band
+ *  \param band    followed borders
+ *  \param parent  if not null, loop directly enclosing each loop (-1 if none), only for a band covering the shape
+ */
+template<typename Pixel, typename Corners>
+static void FollowBand(const Pixel &pixel, const Corners &corners, unsigned int width, unsigned int height, unsigned int lbeg, unsigned int lend, BandBorders &band, std::vector<int> *parent = nullptr)
+{
+	// borders already followed, from the corners of the current line, and columns to reset
+	std::vector<unsigned char> visited(width+1,0);
+	std::vector<unsigned int> visitedcol(0);
+	// borders already followed, from the corners of the other lines (column * 4 + direction)
+	std::vector<std::vector<unsigned int> > pending(lend-lbeg);
+	unsigned int lcur = height+1;
+
+	// loop of the vertical borders of the current line of pixels (-1 if none), and columns to reset
+	std::vector<int> owner(0);
+	std::vector<unsigned int> ownercol(0);
+	// vertical borders of the other lines of pixels (column, loop)
+	std::vector<std::vector<std::pair<unsigned int,int> > > ownerpending(0);
+	if(parent)
+	{
+		parent->clear();
+		owner.assign(width+1,-1);
+		ownerpending.resize(height);
+	}
+
+	auto follow = [&](unsigned int c, unsigned int l, unsigned int d0)
+	{
+		unsigned int cc = c, lc = l, d = d0;
+		uint64_t key = ((uint64_t)c + (uint64_t)(width+1) * l) * 4 + d0;
+		band.begin.push_back(key);
+		do
+		{
+			band.vertices.push_back(cc + (width+1) * lc);
+			if(lc == lcur)
+			{
+				if(!visited[cc])
+					visitedcol.push_back(cc);
+				visited[cc] |= (unsigned char)(1 << d);
+			}
+			else
+				pending[lc-lbeg].push_back(cc*4 + d);
+
+			if(parent && (d == 1 || d == 3))
+			{
+				// vertical border, in the line of pixels below (down) or above (up) the corner
+				unsigned int lpix = (d == 1) ? lc : lc-1;
+				if(lpix == lcur)
+				{
+					ownercol.push_back(cc);
+					owner[cc] = band.begin.size()-1;
+				}
+				else
+					ownerpending[lpix].push_back(std::pair<unsigned int,int>(cc,band.begin.size()-1));
+			}
+
+			cc += dircol[d];
+			lc += dirlin[d];
+			d = NextDirection(pixel,cc,lc,d);
+			
+			if(lc < lbeg || lc >= lend)
+			{
+				// the chain leaves the band
+				key = ((uint64_t)cc + (uint64_t)(width+1) * lc) * 4 + d;
+				break;
+			}
+		}while(cc != c || lc != l || d != d0);
+		band.end.push_back(key);
+		band.offset.push_back(band.vertices.size());
+	};
+
+	// chains entering from the previous band
+	if(lbeg != 0)
+		for(unsigned int c = 0; c <= width; c++)
+			if(OutDirections(pixel,c,lbeg-1) & 2)
+				follow(c,lbeg,NextDirection(pixel,c,lbeg,1));
+	
+	// chains entering from the next band
+	if(lend != height+1)
+		for(unsigned int c = 0; c <= width; c++)
+			if(OutDirections(pixel,c,lend) & 8)
+				follow(c,lend-1,NextDirection(pixel,c,lend-1,3));
+
+	for(lcur = lbeg; lcur < lend; lcur++)
+	{
+		// only the columns set on the previous line are reset
+		for(unsigned int i = 0; i < visitedcol.size(); i++)
+			visited[visitedcol[i]] = 0;
+		visitedcol.clear();
+		std::vector<unsigned int> &pend = pending[lcur-lbeg];
+		for(unsigned int i = 0; i < pend.size(); i++)
+		{
+			if(!visited[pend[i]/4])
+				visitedcol.push_back(pend[i]/4);
+			visited[pend[i]/4] |= (unsigned char)(1 << (pend[i]%4));
+		}
+		std::vector<unsigned int>().swap(pend);
+
+		if(parent && lcur < height)
+		{
+			for(unsigned int i = 0; i < ownercol.size(); i++)
+				owner[ownercol[i]] = -1;
+			ownercol.clear();
+			for(unsigned int i = 0; i < ownerpending[lcur].size(); i++)
+			{
+				ownercol.push_back(ownerpending[lcur][i].first);
+				owner[ownerpending[lcur][i].first] = ownerpending[lcur][i].second;
+			}
+			std::vector<std::pair<unsigned int,int> >().swap(ownerpending[lcur]);
+		}
+		
+		// loop of the nearest vertical border on the left
+		int left = -1;
+		corners(lcur,[&](unsigned int c)
+		{
+			unsigned char out = OutDirections(pixel,c,lcur);
+			for(unsigned int d0 = 0; d0 < 4; d0++)
+				if((out & (1 << d0)) && !(visited[c] & (1 << d0)))
+				{
+					if(parent)
+					{
+						// loops begin to the right (outer border) or down (hole): the left border
+						// encloses the new loop if it is of the other kind, else they are siblings
+						if(left == -1)
+							parent->push_back(-1);
+						else if(band.begin[left]%4 != d0)
+							parent->push_back(left);
+						else
+							parent->push_back((*parent)[left]);
+					}
+					follow(c,lcur,d0);
+				}
+			
+			if(parent && lcur < height && owner[c] != -1)
+				left = owner[c];
+		});
+	}
+}
+
+/**
+ *  \brief Adds corner loops to a boundary
+ *
+ *  \param vertices corners of the loops, one after the other
+ *  \param offset   first corner of each loop (plus the end)
+ *  \param order    order in which the loops are added
+ *  \param width    width of the shape
+ *  \param bnd      boundary in which the loops are added
+ */
+static void AddLoops(const std::vector<unsigned int> &vertices, const std::vector<unsigned int> &offset, const std::vector<unsigned int> &order, unsigned int width, boundary::DiscreteBoundary<2>::Ptr bnd)
+{
+	std::vector<Eigen::Vector2d> vec_vert;
+	for(unsigned int i = 0; i < order.size(); i++)
+	{
+		vec_vert.resize(offset[order[i]+1] - offset[order[i]]);
+		for(unsigned int j = 0; j < vec_vert.size(); j++)
+		{
+			unsigned int ind = vertices[offset[order[i]] + j];
+			vec_vert[j] = Eigen::Vector2d((double)(ind%(width+1)),(double)(ind/(width+1)));
+		}
+		bnd->addVerticesVector(vec_vert);
+	}
+}
+
+/**
+ *  \brief Border following on the whole shape
+ *
+ *  \tparam Pixel   pixel accessor, returning false outside of the shape
+ *  \tparam Corners corners enumerator, visiting in order the corners of a line which may have borders
+ *
+ *  \param pixel   pixel accessor
+ *  \param corners corners enumerator
+ *  \param width   width of the shape
+ *  \param height  height of the shape
+ *  \param frame   frame of the shape
+ *  \param parent  if not null, loop directly enclosing each loop (-1 if none)
+ *
+ *  \return boundary associated to the shape
+ */
+template<typename Pixel, typename Corners>
+static boundary::DiscreteBoundary<2>::Ptr FollowShape(const Pixel &pixel, const Corners &corners, unsigned int width, unsigned int height, const mathtools::affine::Frame<2>::Ptr frame, std::vector<int> *parent)
+{
+	boundary::DiscreteBoundary<2>::Ptr bnd(new boundary::DiscreteBoundary<2>(frame));
+
+	// one band, in which loops are found in order
+	BandBorders band;
+	FollowBand(pixel,corners,width,height,0,height+1,band,parent);
+
+	std::vector<unsigned int> order(band.begin.size());
+	for(unsigned int i = 0; i < order.size(); i++)
+		order[i] = i;
+	AddLoops(band.vertices,band.offset,order,width,bnd);
+
+	return bnd;
+}
+
+/**
+ *  \brief Border following on a discrete shape
+ *
+ *  \param dissh  discrete shape
+ *  \param parent if not null, loop directly enclosing each loop (-1 if none)
+ *
+ *  \return boundary associated to discrete shape
+ */
+static boundary::DiscreteBoundary<2>::Ptr FollowShape(const shape::DiscreteShape<2>::Ptr dissh, std::vector<int> *parent)
+{
+	const shape::DiscreteShape<2> &shp = *dissh;
+	const int width = shp.getWidth();
+	const int height = shp.getHeight();
+	const unsigned char *disc = shp.getData();
+	const std::size_t stride = shp.getStride();
+	
+	auto pixel = [disc,stride,width,height](int c, int l)
+	{
+		return c >= 0 && l >= 0 && c < width && l < height && disc[c + stride * l] != 0;
+	};
+	
+	// only the corners of the pixels of the bounding box can have borders
+	const shape::DiscreteShape<2>::BoundingBox bbox = shp.getBoundingBox();
+	auto corners = [&bbox](unsigned int l, auto &&visit)
+	{
+		if(bbox.isEmpty() || l < bbox.lmin || l > bbox.lmax)
+			return;
+		for(unsigned int c = bbox.cmin; c <= bbox.cmax; c++)
+			visit(c);
+	};
+
+	return FollowShape(pixel,corners,width,height,shp.getFrame(),parent);
+}
+
+/**
+ *  \brief Border following on a run length encoded shape
+ *
+ *  \details Only the corners at the extremities of the runs, and the ones between the runs of two
+ *           consecutive rows which differ, are visited.
+ *
+ *  \param rlesh  run length encoded shape
+ *  \param parent if not null, loop directly enclosing each loop (-1 if none)
+ *
+ *  \return boundary associated to the shape
+ */
+static boundary::DiscreteBoundary<2>::Ptr FollowShape(const shape::RLEShape<2>::Ptr rlesh, std::vector<int> *parent)
+{
+	const int width = rlesh->getWidth();
+	const int height = rlesh->getHeight();
+	
+	auto pixel = [&rlesh,width,height](int c, int l)
+	{
+		return c >= 0 && l >= 0 && c < width && l < height && rlesh->getPixel(c,l);
+	};
+	
+	// extremities of the runs of the rows above and below a line of corners
+	std::vector<std::pair<unsigned int,unsigned int> > extremities(0);
+	auto corners = [&rlesh,&extremities,height](unsigned int l, auto &&visit)
+	{
+		extremities.clear();
+		for(unsigned int r = 0; r < 2; r++)
+		{
+			// row above (r = 0) or below (r = 1) the corners
+			if(l+r == 0 || (int)(l+r) > height)
+				continue;
+			const std::vector<shape::RLEShape<2>::Run> &runs = rlesh->getRow(l+r-1);
+			for(unsigned int i = 0; i < runs.size(); i++)
+			{
+				extremities.push_back(std::pair<unsigned int,unsigned int>(runs[i].beg,r));
+				extremities.push_back(std::pair<unsigned int,unsigned int>(runs[i].end,r));
+			}
+		}
+		std::sort(extremities.begin(),extremities.end());
+
+		bool in[2] = {false,false};
+		for(unsigned int i = 0; i < extremities.size(); i++)
+		{
+			in[extremities[i].second] = !in[extremities[i].second];
+			if(i+1 < extremities.size() && extremities[i+1].first == extremities[i].first)
+				continue;
+
+			visit(extremities[i].first);
+			
+			// horizontal borders between the rows
+			if(in[0] != in[1] && i+1 < extremities.size())
+				for(unsigned int c = extremities[i].first+1; c < extremities[i+1].first; c++)
+					visit(c);
+		}
+	};
+
+	return FollowShape(pixel,corners,width,height,rlesh->getFrame(),parent);
+}
+
+boundary::DiscreteBoundary<2>::Ptr algorithm::extractboundary::BorderFollowing(const shape::DiscreteShape<2>::Ptr dissh)
+{
+	return FollowShape(dissh,nullptr);
+}
+
+boundary::DiscreteBoundary<2>::Ptr algorithm::extractboundary::BorderFollowing(const shape::DiscreteShape<2>::Ptr dissh, std::vector<int> &parent)
+{
+	return FollowShape(dissh,&parent);
+}
+
+boundary::DiscreteBoundary<2>::Ptr algorithm::extractboundary::BorderFollowing(const shape::RLEShape<2>::Ptr rlesh)
+{
+	return FollowShape(rlesh,nullptr);
+}
+
+boundary::DiscreteBoundary<2>::Ptr algorithm::extractboundary::BorderFollowing(const shape::RLEShape<2>::Ptr rlesh, std::vector<int> &parent)
+{
+	return FollowShape(rlesh,&parent);
+}
+
+boundary::DiscreteBoundary<2>::Ptr algorithm::extractboundary::TiledBorderFollowing(const shape::DiscreteShape<2>::Ptr dissh, unsigned int nbbands)
+{
+	boundary::DiscreteBoundary<2>::Ptr bnd(new boundary::DiscreteBoundary<2>(dissh->getFrame()));
+
+	const shape::DiscreteShape<2> &shp = *dissh;
+	const int width = shp.getWidth();
+	const int height = shp.getHeight();
+	const unsigned char *disc = shp.getData();
+	const std::size_t stride = shp.getStride();
+	
+	auto pixel = [disc,stride,width,height](int c, int l)
+	{
+		return c >= 0 && l >= 0 && c < width && l < height && disc[c + stride * l] != 0;
+	};
+
+	if(nbbands == 0)
+		throw std::logic_error("algorithm::extractboundary::TiledBorderFollowing : at least one band is needed");
+
+	// the bands only cover the lines of corners of the bounding box
+	const shape::DiscreteShape<2>::BoundingBox bbox = shp.getBoundingBox();
+	if(bbox.isEmpty())
+		return bnd;
+	const unsigned int nblines = bbox.lmax - bbox.lmin + 1;
+	if(nbbands > nblines)
+		nbbands = nblines;
+	
+	auto corners = [&bbox](unsigned int, auto &&visit)
+	{
+		for(unsigned int c = bbox.cmin; c <= bbox.cmax; c++)
+			visit(c);
+	};
+	
+	//first step: chains of each band
+	std::vector<BandBorders> bands(nbbands);
+#pragma omp parallel for schedule(dynamic)
+	for(unsigned int b = 0; b < nbbands; b++)
+	{
+		unsigned int lbeg = bbox.lmin + (unsigned int)(((uint64_t)nblines * b) / nbbands);
+		unsigned int lend = bbox.lmin + (unsigned int)(((uint64_t)nblines * (b+1)) / nbbands);
+		FollowBand(pixel,corners,width,height,lbeg,lend,bands[b]);
+	}
+
+	//second step: stitch the chains at the seams
+	std::vector<unsigned int> chainband(0), chainind(0);
+	std::vector<std::pair<uint64_t,unsigned int> > chainbegin(0);
+	for(unsigned int b = 0; b < nbbands; b++)
+		for(unsigned int i = 0; i < bands[b].begin.size(); i++)
+		{
+			chainbegin.push_back(std::pair<uint64_t,unsigned int>(bands[b].begin[i],chainband.size()));
+			chainband.push_back(b);
+			chainind.push_back(i);
+		}
+	std::sort(chainbegin.begin(),chainbegin.end());
+
+	std::vector<unsigned int> vertices(0), offset(1,0);
+	std::vector<uint64_t> loopkey(0);
+	std::vector<bool> stitched(chainband.size(),false);
+	for(unsigned int k = 0; k < chainband.size(); k++)
+	{
+		if(stitched[k])
+			continue;
+
+		unsigned int first = vertices.size();
+		unsigned int ch = k;
+		do
+		{
+			stitched[ch] = true;
+			const BandBorders &band = bands[chainband[ch]];
+			vertices.insert(vertices.end(),band.vertices.begin() + band.offset[chainind[ch]],band.vertices.begin() + band.offset[chainind[ch]+1]);
+			
+			std::vector<std::pair<uint64_t,unsigned int> >::const_iterator it =
+				std::lower_bound(chainbegin.begin(),chainbegin.end(),std::pair<uint64_t,unsigned int>(band.end[chainind[ch]],0));
+			if(it == chainbegin.end() || it->first != band.end[chainind[ch]])
+				throw std::logic_error("algorithm::extractboundary::TiledBorderFollowing : open chain");
+			ch = it->second;
+		}while(ch != k);
+
+		// the loop begins at its first border in raster order
+		uint64_t keymin = 0;
+		unsigned int posmin = 0;
+		unsigned int nbvert = vertices.size() - first;
+		for(unsigned int i = 0; i < nbvert; i++)
+		{
+			unsigned int ind = vertices[first + i], next = vertices[first + (i+1)%nbvert];
+			unsigned int d = (next == ind+1) ? 0 : (next == ind + width+1) ? 1 : (next+1 == ind) ? 2 : 3;
+			uint64_t key = (uint64_t)ind * 4 + d;
+			if(i == 0 || key < keymin)
+			{
+				keymin = key;
+				posmin = i;
+			}
+		}
+		std::rotate(vertices.begin() + first,vertices.begin() + first + posmin,vertices.end());
+		offset.push_back(vertices.size());
+		loopkey.push_back(keymin);
+	}
+
+	//third step: loops in raster order
+	std::vector<unsigned int> order(loopkey.size());
+	for(unsigned int i = 0; i < order.size(); i++)
+		order[i] = i;
+	std::sort(order.begin(),order.end(),[&loopkey](unsigned int i1, unsigned int i2){return loopkey[i1] < loopkey[i2];});
+	AddLoops(vertices,offset,order,width,bnd);
+
+	return bnd;
+}
@@ -0,0 +1,113 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file BorderFollowing.h
+ *  \brief Extracts a boundary by following the borders in one raster scan
+ *  \author Bastien Durix
+ */
+
+#ifndef _BORDERFOLLOWING_H_
+#define _BORDERFOLLOWING_H_
+
+#include <shape/DiscreteShape.h>
+#include <shape/RLEShape.h>
+#include <boundary/DiscreteBoundary2.h>
+
+/**
+ *  \brief Lots of algorithms
+ */
+namespace algorithm
+{
+	/**
+	 *  \brief Boundary extraction
+	 */
+	namespace extractboundary
+	{
+		/**
+		 *  \brief Extract boundary by border following
+		 *
+		 *  \details The pixels corners are scanned row wise, and each border met for the first time is
+		 *           followed until it closes. Loops are the same as the ones of NaiveBoundary, in the same
+		 *           order and with the same first vertex. Where two pixels only touch by a corner, the
+		 *           borders turn so that shape is 4-connected.
+		 *
+		 *  \param dissh discrete shape
+		 *
+		 *  \return boundary associated to discrete shape
+		 */
+		boundary::DiscreteBoundary<2>::Ptr BorderFollowing(const shape::DiscreteShape<2>::Ptr dissh);
+
+		/**
+		 *  \brief Extract boundary by border following, with the hierarchy of its loops
+		 *
+		 *  \details Outer borders of the shape components go clockwise (the shape on their right),
+		 *           borders of holes go counterclockwise. The parent of a hole is the outer border of
+		 *           the component containing it, the parent of the outer border of a component lying
+		 *           in a hole is the border of this hole.
+		 *
+		 *  \param dissh  discrete shape
+		 *  \param parent index of the loop directly enclosing each loop, -1 for outermost loops
+		 *
+		 *  \return boundary associated to discrete shape
+		 */
+		boundary::DiscreteBoundary<2>::Ptr BorderFollowing(const shape::DiscreteShape<2>::Ptr dissh, std::vector<int> &parent);
+
+		/**
+		 *  \brief Extract boundary of a run length encoded shape by border following
+		 *
+		 *  \details Same boundary as the one of the decoded shape, in time proportional to the number
+		 *           of runs and to the length of the boundary
+		 *
+		 *  \param rlesh run length encoded shape
+		 *
+		 *  \return boundary associated to the shape
+		 */
+		boundary::DiscreteBoundary<2>::Ptr BorderFollowing(const shape::RLEShape<2>::Ptr rlesh);
+
+		/**
+		 *  \brief Extract boundary of a run length encoded shape by border following, with the hierarchy of its loops
+		 *
+		 *  \param rlesh  run length encoded shape
+		 *  \param parent index of the loop directly enclosing each loop, -1 for outermost loops
+		 *
+		 *  \return boundary associated to the shape
+		 */
+		boundary::DiscreteBoundary<2>::Ptr BorderFollowing(const shape::RLEShape<2>::Ptr rlesh, std::vector<int> &parent);
+
+		/**
+		 *  \brief Extract boundary by border following, in parallel bands of lines
+		 *
+		 *  \details Borders are followed in each band independently, then the chains crossing the
+		 *           seams between bands are stitched. The boundary is the same as BorderFollowing's.
+		 *
+		 *  \param dissh   discrete shape
+		 *  \param nbbands number of bands
+		 *
+		 *  \return boundary associated to discrete shape
+		 */
+		boundary::DiscreteBoundary<2>::Ptr TiledBorderFollowing(const shape::DiscreteShape<2>::Ptr dissh, unsigned int nbbands = 64);
+	}
+}
+
+#endif //_BORDERFOLLOWING_H_
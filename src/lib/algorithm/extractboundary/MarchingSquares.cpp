@@ -0,0 +1,148 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file MarchingSquares.cpp
+ *  \brief Extracts a sub-pixel boundary with marching squares
+ *  \author Bastien Durix
+ */
+
+#include "MarchingSquares.h"
+#include "BorderFollowing.h"
+#include <cmath>
+#include <stdexcept>
+
+/**
+ *  \brief Tests if a vertex lies on the segment between its neighbors
+ *
+ *  \param vert1 previous vertex
+ *  \param vert2 tested vertex
+ *  \param vert3 next vertex
+ *
+ *  \return true if the vertex can be removed
+ */
+static inline bool Aligned(const Eigen::Vector2d &vert1, const Eigen::Vector2d &vert2, const Eigen::Vector2d &vert3)
+{
+	Eigen::Vector2d vec1 = vert2 - vert1, vec2 = vert3 - vert2;
+	return std::abs(vec1.x() * vec2.y() - vec1.y() * vec2.x()) <= 1e-9 && vec1.dot(vec2) > 0.0;
+}
+
+/**
+ *  \brief Marching squares on a scalar field
+ *
+ *  \details The pixels above the iso-level are followed as a discrete shape: each border between
+ *           a pixel inside and a pixel outside gives one vertex, between their centers.
+ *
+ *  \tparam Value value accessor, on pixels of the field
+ *
+ *  \param value   value accessor
+ *  \param width   width of the field
+ *  \param height  height of the field
+ *  \param options extraction options
+ *  \param frame   frame of the field
+ *
+ *  \return boundary associated to the iso-level
+ */
+template<typename Value>
+static boundary::DiscreteBoundary<2>::Ptr MarchingSquaresField(const Value &value, unsigned int width, unsigned int height, const algorithm::extractboundary::OptionsMarchingSquares &options, const mathtools::affine::Frame<2>::Ptr frame)
+{
+	if(options.isolevel < 0.0)
+		throw std::logic_error("algorithm::extractboundary::MarchingSquares : the field is 0 outside, the iso-level has to be positive");
+
+	shape::DiscreteShape<2>::Ptr thres(new shape::DiscreteShape<2>(width,height,frame));
+	std::vector<unsigned char> &disc = thres->getWritableContainer();
+#pragma omp parallel for
+	for(unsigned int l = 0; l < height; l++)
+		for(unsigned int c = 0; c < width; c++)
+			disc[c + width * l] = value(c,l) > options.isolevel ? 255 : 0;
+
+	boundary::DiscreteBoundary<2>::Ptr crack = algorithm::extractboundary::BorderFollowing(thres);
+	boundary::DiscreteBoundary<2>::Ptr bnd(new boundary::DiscreteBoundary<2>(frame));
+	
+	std::vector<Eigen::Vector2d> vec_vert(0);
+	for(unsigned int k = 0; k < crack->getNbLoops(); k++)
+	{
+		vec_vert.clear();
+		for(unsigned int i = crack->getLoopBegin(k); i < crack->getLoopEnd(k); i++)
+		{
+			Eigen::Vector2d pt1 = crack->getCoordinates(i);
+			Eigen::Vector2d pt2 = crack->getCoordinates(crack->getNext(i));
+			
+			// the shape is on the right of the border
+			Eigen::Vector2d normal(pt1.y() - pt2.y(), pt2.x() - pt1.x());
+			Eigen::Vector2d ptin  = 0.5 * (pt1 + pt2 + normal);
+			Eigen::Vector2d ptout = 0.5 * (pt1 + pt2 - normal);
+			
+			double valin  = value((int)std::floor(ptin.x()),(int)std::floor(ptin.y()));
+			double valout = value((int)std::floor(ptout.x()),(int)std::floor(ptout.y()));
+			double t = (valin - options.isolevel) / (valin - valout);
+			Eigen::Vector2d vert = ptin + t * (ptout - ptin);
+
+			// removes the previous vertex if it is aligned with its neighbors
+			if(options.simplify && vec_vert.size() >= 2 && Aligned(vec_vert[vec_vert.size()-2],vec_vert[vec_vert.size()-1],vert))
+				vec_vert.pop_back();
+			vec_vert.push_back(vert);
+		}
+
+		if(options.simplify)
+		{
+			// alignments around the first vertex
+			if(vec_vert.size() > 3 && Aligned(vec_vert[vec_vert.size()-2],vec_vert[vec_vert.size()-1],vec_vert[0]))
+				vec_vert.pop_back();
+			if(vec_vert.size() > 3 && Aligned(vec_vert[vec_vert.size()-1],vec_vert[0],vec_vert[1]))
+				vec_vert.erase(vec_vert.begin());
+		}
+		bnd->addVerticesVector(vec_vert);
+	}
+
+	return bnd;
+}
+
+boundary::DiscreteBoundary<2>::Ptr algorithm::extractboundary::MarchingSquares(const shape::DiscreteShape<2>::Ptr dissh, const OptionsMarchingSquares &options)
+{
+	const shape::DiscreteShape<2> &shp = *dissh;
+	const int width = shp.getWidth();
+	const int height = shp.getHeight();
+	const unsigned char *disc = shp.getData();
+	const std::size_t stride = shp.getStride();
+	
+	auto value = [disc,stride,width,height](int c, int l)
+	{
+		return (c >= 0 && l >= 0 && c < width && l < height) ? (double)disc[c + stride * l] : 0.0;
+	};
+
+	return MarchingSquaresField(value,width,height,options,dissh->getFrame());
+}
+
+boundary::DiscreteBoundary<2>::Ptr algorithm::extractboundary::MarchingSquares(const std::vector<float> &field, unsigned int width, unsigned int height, const OptionsMarchingSquares &options, const mathtools::affine::Frame<2>::Ptr frame)
+{
+	if(field.size() != (std::size_t)width * (std::size_t)height)
+		throw std::logic_error("algorithm::extractboundary::MarchingSquares : field size is not width * height");
+
+	auto value = [&field,width,height](int c, int l)
+	{
+		return (c >= 0 && l >= 0 && c < (int)width && l < (int)height) ? (double)field[c + width * l] : 0.0;
+	};
+
+	return MarchingSquaresField(value,width,height,options,frame);
+}
@@ -0,0 +1,101 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file MarchingSquares.h
+ *  \brief Extracts a sub-pixel boundary with marching squares
+ *  \author Bastien Durix
+ */
+
+#ifndef _MARCHINGSQUARES_H_
+#define _MARCHINGSQUARES_H_
+
+#include <vector>
+#include <shape/DiscreteShape.h>
+#include <boundary/DiscreteBoundary2.h>
+
+/**
+ *  \brief Lots of algorithms
+ */
+namespace algorithm
+{
+	/**
+	 *  \brief Boundary extraction
+	 */
+	namespace extractboundary
+	{
+		/**
+		 *  \brief Marching squares options structure
+		 */
+		struct OptionsMarchingSquares
+		{
+			/**
+			 *  \brief Iso-level of the contours, values strictly above are inside the shape
+			 */
+			double isolevel;
+
+			/**
+			 *  \brief Removes the vertices exactly aligned with their neighbors
+			 */
+			bool simplify;
+
+			/**
+			 *  \brief Default constructor
+			 */
+			OptionsMarchingSquares(double isolevel_ = 127.5, bool simplify_ = false) :
+				isolevel(isolevel_), simplify(simplify_) {}
+		};
+
+		/**
+		 *  \brief Extract boundary with marching squares on the values of a discrete shape
+		 *
+		 *  \details Pixel (c,l) is sampled at (c+0.5,l+0.5), and is 0 outside of the shape. Each
+		 *           vertex is linearly interpolated between a pixel inside and a pixel outside. Loops
+		 *           are oriented and ordered as the ones of BorderFollowing, and saddles are solved
+		 *           the same way: there are as many vertices as pixel borders. With the simplify option,
+		 *           runs of aligned vertices are merged, which shortens the straight and 45 degrees
+		 *           parts of binary shapes, but rarely applies to vertices interpolated between gray levels.
+		 *
+		 *  \param dissh   discrete shape, whose values are sampled
+		 *  \param options extraction options
+		 *
+		 *  \return boundary associated to the iso-level
+		 */
+		boundary::DiscreteBoundary<2>::Ptr MarchingSquares(const shape::DiscreteShape<2>::Ptr dissh, const OptionsMarchingSquares &options = OptionsMarchingSquares());
+
+		/**
+		 *  \brief Extract boundary with marching squares on a scalar field
+		 *
+		 *  \param field   values of the field, row wise
+		 *  \param width   width of the field
+		 *  \param height  height of the field
+		 *  \param options extraction options
+		 *  \param frame   frame of the field
+		 *
+		 *  \return boundary associated to the iso-level
+		 */
+		boundary::DiscreteBoundary<2>::Ptr MarchingSquares(const std::vector<float> &field, unsigned int width, unsigned int height, const OptionsMarchingSquares &options, const mathtools::affine::Frame<2>::Ptr frame = mathtools::affine::Frame<2>::CanonicFrame());
+	}
+}
+
+#endif //_MARCHINGSQUARES_H_
@@ -28,6 +28,7 @@ SOFTWARE.
  */
 
 #include "NaiveBoundary.h"
+#include <map>
 
 boundary::DiscreteBoundary<2>::Ptr algorithm::extractboundary::NaiveBoundary(const shape::DiscreteShape<2>::Ptr dissh)
 {
@@ -35,15 +36,20 @@ boundary::DiscreteBoundary<2>::Ptr algorithm::extractboundary::NaiveBoundary(con
 	
 	std::list<std::pair<unsigned int,unsigned int> > list_edg; //list of edges
 
+	const shape::DiscreteShape<2> &shp = *dissh;
+	const unsigned char *disc = shp.getData();
+	const std::size_t stride = shp.getStride();
+	const shape::DiscreteShape<2>::BoundingBox bbox = shp.getBoundingBox(); //only pixels in the box can have edges
+
 	//cf: https://en.wikipedia.org/wiki/Marching_squares
 	//first step: vertices adjacency computation
 	#pragma omp parallel for
-	for(unsigned int c = 0; c < dissh->getWidth(); c++)
+	for(unsigned int c = bbox.cmin; c < bbox.cmax; c++)
 	{
 		#pragma omp parallel for
-		for(unsigned int l = 0; l < dissh->getHeight(); l++)
+		for(unsigned int l = bbox.lmin; l < bbox.lmax; l++)
 		{
-			if(dissh->getContainer()[c + dissh->getWidth() * l])
+			if(disc[c + stride * l])
 			{
 				unsigned int ind1 = c   + (dissh->getWidth()+1) * l;
 				unsigned int ind2 = c+1 + (dissh->getWidth()+1) * l;
@@ -55,10 +61,10 @@ boundary::DiscreteBoundary<2>::Ptr algorithm::extractboundary::NaiveBoundary(con
 				bool left = false;
 				bool right = false;
 				
-				if(c != 0)                    if(dissh->getContainer()[(c-1) + dissh->getWidth() * l]) left = true;
-				if(l != 0)                    if(dissh->getContainer()[c + dissh->getWidth() * (l-1)]) up = true;
-				if(c != dissh->getWidth()-1)  if(dissh->getContainer()[(c+1) + dissh->getWidth() * l]) right = true;
-				if(l != dissh->getHeight()-1) if(dissh->getContainer()[c + dissh->getWidth() * (l+1)]) down = true;
+				if(c != 0)                    if(disc[(c-1) + stride * l]) left = true;
+				if(l != 0)                    if(disc[c + stride * (l-1)]) up = true;
+				if(c != dissh->getWidth()-1)  if(disc[(c+1) + stride * l]) right = true;
+				if(l != dissh->getHeight()-1) if(disc[c + stride * (l+1)]) down = true;
 
 
 				if(!left || !right || !up || !down)
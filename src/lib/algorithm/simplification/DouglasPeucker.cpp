@@ -0,0 +1,145 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file DouglasPeucker.cpp
+ *  \brief Simplifies a boundary with the Douglas-Peucker algorithm
+ *  \author Bastien Durix
+ */
+
+#include "DouglasPeucker.h"
+#include <algorithm>
+#include <utility>
+
+/**
+ *  \brief Squared distance between a point and a segment
+ *
+ *  \param pt  point
+ *  \param pt1 first extremity of the segment
+ *  \param pt2 second extremity of the segment
+ *
+ *  \return squared distance
+ */
+static inline double SqSegDist(const Eigen::Vector2d &pt, const Eigen::Vector2d &pt1, const Eigen::Vector2d &pt2)
+{
+	Eigen::Vector2d vec = pt2 - pt1;
+	double sqlen = vec.squaredNorm();
+	double t = sqlen == 0.0 ? 0.0 : std::min(std::max((pt - pt1).dot(vec) / sqlen, 0.0), 1.0);
+	return (pt1 + t * vec - pt).squaredNorm();
+}
+
+/**
+ *  \brief Selects the vertices of a loop kept by the simplification
+ *
+ *  \param vert    coordinates of the vertices
+ *  \param beg     first vertex of the loop
+ *  \param end     vertex after the loop
+ *  \param epsilon maximal deviation of the removed vertices
+ *  \param keep    kept vertices, updated on the loop
+ */
+static void SimplifyLoop(const boundary::DiscreteBoundary<2>::VerticesView &vert, unsigned int beg, unsigned int end, double epsilon, std::vector<char> &keep)
+{
+	unsigned int nbvert = end - beg;
+	auto point = [&vert,beg,nbvert](unsigned int i)
+	{
+		return Eigen::Vector2d(vert.x[beg + i%nbvert],vert.y[beg + i%nbvert]);
+	};
+
+	keep[beg] = 1;
+	if(nbvert <= 3)
+	{
+		std::fill(keep.begin()+beg,keep.begin()+end,1);
+		return;
+	}
+
+	// the loop is split at the vertex farthest from the first one
+	unsigned int far = 0;
+	double sqdistmax = 0.0;
+	for(unsigned int i = 1; i < nbvert; i++)
+	{
+		double sqdist = (point(i) - point(0)).squaredNorm();
+		if(sqdist > sqdistmax)
+		{
+			sqdistmax = sqdist;
+			far = i;
+		}
+	}
+	if(far == 0)
+		return;
+	keep[beg + far] = 1;
+
+	// chains to simplify, loop index nbvert being the first vertex again
+	std::vector<std::pair<unsigned int,unsigned int> > chains(0);
+	chains.push_back(std::pair<unsigned int,unsigned int>(0,far));
+	chains.push_back(std::pair<unsigned int,unsigned int>(far,nbvert));
+
+	double sqepsilon = epsilon * epsilon;
+	while(chains.size() != 0)
+	{
+		std::pair<unsigned int,unsigned int> chain = chains.back();
+		chains.pop_back();
+
+		Eigen::Vector2d pt1 = point(chain.first), pt2 = point(chain.second);
+		unsigned int ind = chain.first;
+		double sqdev = 0.0;
+		for(unsigned int i = chain.first+1; i < chain.second; i++)
+		{
+			double sqdist = SqSegDist(point(i),pt1,pt2);
+			if(sqdist > sqdev)
+			{
+				sqdev = sqdist;
+				ind = i;
+			}
+		}
+
+		if(sqdev > sqepsilon)
+		{
+			keep[beg + ind] = 1;
+			chains.push_back(std::pair<unsigned int,unsigned int>(chain.first,ind));
+			chains.push_back(std::pair<unsigned int,unsigned int>(ind,chain.second));
+		}
+	}
+}
+
+boundary::DiscreteBoundary<2>::Ptr algorithm::simplification::DouglasPeucker(const boundary::DiscreteBoundary<2>::Ptr bnd, double epsilon)
+{
+	boundary::DiscreteBoundary<2>::Ptr simpl(new boundary::DiscreteBoundary<2>(bnd->getFrame()));
+	boundary::DiscreteBoundary<2>::VerticesView vert = bnd->getView();
+
+	std::vector<char> keep(vert.size,0);
+#pragma omp parallel for schedule(dynamic)
+	for(unsigned int k = 0; k < bnd->getNbLoops(); k++)
+		SimplifyLoop(vert,bnd->getLoopBegin(k),bnd->getLoopEnd(k),epsilon,keep);
+
+	std::vector<Eigen::Vector2d> vec_vert(0);
+	for(unsigned int k = 0; k < bnd->getNbLoops(); k++)
+	{
+		vec_vert.clear();
+		for(unsigned int i = bnd->getLoopBegin(k); i < bnd->getLoopEnd(k); i++)
+			if(keep[i])
+				vec_vert.push_back(Eigen::Vector2d(vert.x[i],vert.y[i]));
+		simpl->addVerticesVector(vec_vert);
+	}
+
+	return simpl;
+}
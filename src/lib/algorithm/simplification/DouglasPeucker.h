@@ -0,0 +1,61 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file DouglasPeucker.h
+ *  \brief Simplifies a boundary with the Douglas-Peucker algorithm
+ *  \author Bastien Durix
+ */
+
+#ifndef _DOUGLASPEUCKER_H_
+#define _DOUGLASPEUCKER_H_
+
+#include <boundary/DiscreteBoundary2.h>
+
+/**
+ *  \brief Lots of algorithms
+ */
+namespace algorithm
+{
+	/**
+	 *  \brief Boundary simplification
+	 */
+	namespace simplification
+	{
+		/**
+		 *  \brief Simplifies each loop of a boundary with the Douglas-Peucker algorithm
+		 *
+		 *  \details Each removed vertex is at most at epsilon from the segment replacing it, so that the
+		 *           simplified boundary is at most at Hausdorff distance epsilon from the original one.
+		 *           Loops keep their order and their first vertex.
+		 *
+		 *  \param bnd     boundary to simplify
+		 *  \param epsilon maximal deviation of the removed vertices
+		 *
+		 *  \return simplified boundary
+		 */
+		boundary::DiscreteBoundary<2>::Ptr DouglasPeucker(const boundary::DiscreteBoundary<2>::Ptr bnd, double epsilon);
+	}
+}
+
+#endif //_DOUGLASPEUCKER_H_
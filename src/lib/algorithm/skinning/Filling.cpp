@@ -32,36 +32,186 @@ SOFTWARE.
 #include <opencv2/highgui/highgui.hpp>
 #include <mathtools/geometry/euclidian/HyperSphere.h>
 #include <mathtools/affine/Point.h>
+#include <algorithm>
+#include <cmath>
 
-void algorithm::skinning::Filling(shape::DiscreteShape<2>::Ptr shape, const skeleton::GraphSkel2d::Ptr grskl)
+/**
+ *  \brief Rows of a filled disk, with the midpoint scan of cv::circle
+ *
+ *  \details Both shape representations are filled from these rows, so that they get the same pixels
+ *
+ *  \param sph   disk
+ *  \param frame frame of the filled shape
+ *  \param cc    column of the center of the disk
+ *  \param cl    line of the center of the disk
+ *  \param half  half width of each row, row cl+dl covering columns [cc-half[|dl|],cc+half[|dl|]]
+ */
+static void DiskRows(const mathtools::geometry::euclidian::HyperSphere<2> &sph, const mathtools::affine::Frame<2>::Ptr frame, int &cc, int &cl, std::vector<int> &half)
+{
+	Eigen::Vector2d ctr = sph.getCenter().getCoords(frame);
+	cc = (int)(ctr.x()+0.5);
+	cl = (int)(ctr.y()+0.5);
+	int rad = (int)sph.getRadius();
+
+	half.assign(std::max(rad+1,0),0);
+	int err = 0, dx = rad, dy = 0, plus = 1, minus = 2*rad - 1;
+	while(dx >= dy)
+	{
+		// eight symmetric octants, filled between symmetric points
+		half[dy] = std::max(half[dy],dx);
+		half[dx] = std::max(half[dx],dy);
+
+		dy++;
+		err += plus;
+		plus += 2;
+		if(err > 0)
+		{
+			err -= minus;
+			dx--;
+			minus -= 2;
+		}
+	}
+}
+
+/**
+ *  \brief Adds a filled disk to a discrete shape
+ *
+ *  \param shape shape to fill
+ *  \param sph   disk to add
+ */
+static void FillDisk(shape::DiscreteShape<2>::Ptr shape, const mathtools::geometry::euclidian::HyperSphere<2> &sph)
 {
-	cv::Mat im_shape(shape->getHeight(),shape->getWidth(),CV_8U,&shape->getContainer()[0]);
+	int cc, cl;
+	std::vector<int> half(0);
+	DiskRows(sph,shape->getFrame(),cc,cl,half);
+
+	unsigned char *disc = shape->getWritableData();
+	const std::size_t stride = shape->getStride();
+	for(int dl = -(int)half.size()+1; dl < (int)half.size(); dl++)
+	{
+		int l = cl + dl;
+		if(l < 0 || l >= (int)shape->getHeight())
+			continue;
+
+		int beg = std::max(cc - half[std::abs(dl)],0), end = std::min(cc + half[std::abs(dl)] + 1,(int)shape->getWidth());
+		if(beg < end)
+			std::fill(disc + stride * l + beg, disc + stride * l + end, 255);
+	}
+}
+
+/**
+ *  \brief Adds a filled disk to a run length encoded shape
+ *
+ *  \param shape shape to fill
+ *  \param sph   disk to add
+ */
+static void FillDisk(shape::RLEShape<2>::Ptr shape, const mathtools::geometry::euclidian::HyperSphere<2> &sph)
+{
+	int cc, cl;
+	std::vector<int> half(0);
+	DiskRows(sph,shape->getFrame(),cc,cl,half);
+
+	for(int dl = -(int)half.size()+1; dl < (int)half.size(); dl++)
+	{
+		int l = cl + dl;
+		if(l < 0 || l >= (int)shape->getHeight())
+			continue;
+
+		int beg = std::max(cc - half[std::abs(dl)],0), end = std::min(cc + half[std::abs(dl)] + 1,(int)shape->getWidth());
+		if(beg < end)
+			shape->addRun(l,beg,end);
+	}
+}
+
+/**
+ *  \brief Fills a shape with ellipses
+ *
+ *  \details The ellipses are drawn in an image twice larger than the shape, then downsampled.
+ *           Only the bounding box of the ellipses is drawn, aligned on the pixels of the shape,
+ *           the rest of the shape is empty.
+ *
+ *  \param shape    shape to fill
+ *  \param vec_rect rectangles of the ellipses, in the twice larger image
+ */
+static void FillEllipses(shape::DiscreteShape<2>::Ptr shape, const std::vector<cv::RotatedRect> &vec_rect)
+{
+	cv::Mat im_full(shape->getHeight(),shape->getWidth(),CV_8U,shape->getWritableData(),shape->getStride());
+	im_full.setTo(0);
+
+	cv::Rect rect2;
+	for(unsigned int i = 0; i < vec_rect.size(); i++)
+		rect2 |= vec_rect[i].boundingRect();
+	
+	// one pixel margin around the ellipses
+	int cmin = std::max(rect2.x/2 - 1,0);
+	int lmin = std::max(rect2.y/2 - 1,0);
+	int cmax = std::min((rect2.x + rect2.width)/2 + 2,(int)shape->getWidth());
+	int lmax = std::min((rect2.y + rect2.height)/2 + 2,(int)shape->getHeight());
+	if(vec_rect.size() == 0 || cmin >= cmax || lmin >= lmax)
+		return;
+	cv::Rect roi(cmin,lmin,cmax-cmin,lmax-lmin);
+
+	cv::Mat im_roitimes2(roi.height*2,roi.width*2,CV_8U,cv::Scalar(0));
+	for(unsigned int i = 0; i < vec_rect.size(); i++)
+	{
+		cv::RotatedRect rect(cv::Point2f(vec_rect[i].center.x - 2.0*cmin,vec_rect[i].center.y - 2.0*lmin),vec_rect[i].size,vec_rect[i].angle);
+		cv::ellipse(im_roitimes2,rect,255,-1);
+	}
 	
+	cv::Mat im_shape = im_full(roi);
+	cv::resize(im_roitimes2,im_shape,im_shape.size());
+}
+
+void algorithm::skinning::Filling(shape::DiscreteShape<2>::Ptr shape, const skeleton::GraphSkel2d::Ptr grskl)
+{
 	std::list<unsigned int> lind;
 	grskl->getAllNodes(lind);
 
 	for(std::list<unsigned int>::iterator it = lind.begin(); it != lind.end(); it++)
+		FillDisk(shape,grskl->getNode<mathtools::geometry::euclidian::HyperSphere<2> >(*it));
+}
+
+void algorithm::skinning::Filling(shape::DiscreteShape<2>::Ptr shape, const skeleton::BranchContSkel2d::Ptr contbr, const OptionsFilling &options)
+{
+	for(unsigned int i = 0; i < options.nbcer; i++)
 	{
-		mathtools::geometry::euclidian::HyperSphere<2> sph = grskl->getNode<mathtools::geometry::euclidian::HyperSphere<2> >(*it);
-		
-    	cv::circle(im_shape,cv::Point2i(sph.getCenter().getCoords(shape->getFrame()).x()+0.5,sph.getCenter().getCoords(shape->getFrame()).y()+0.5),sph.getRadius(),255,-1);
+		double t = (double)i/(double)(options.nbcer-1);
+		FillDisk(shape,contbr->getNode<mathtools::geometry::euclidian::HyperSphere<2> >(t));
 	}
 }
 
-void algorithm::skinning::Filling(shape::DiscreteShape<2>::Ptr shape, const skeleton::BranchContSkel2d::Ptr contbr, const OptionsFilling &options)
+void algorithm::skinning::Filling(shape::DiscreteShape<2>::Ptr shape, const skeleton::CompContSkel2d::Ptr contskl, const OptionsFilling &options)
 {
-	cv::Mat im_shape(shape->getHeight(),shape->getWidth(),CV_8U,&shape->getContainer()[0]);
+	std::vector<unsigned int> edge(0);
+	contskl->getAllEdges(edge);
 	
+	for(unsigned int i=0;i<edge.size();i++)
+	{
+		std::pair<unsigned int,unsigned int> ext = contskl->getExtremities(edge[i]);
+		
+		Filling(shape,contskl->getBranch(ext.first,ext.second),options);
+	}
+}
+
+void algorithm::skinning::Filling(shape::RLEShape<2>::Ptr shape, const skeleton::GraphSkel2d::Ptr grskl)
+{
+	std::list<unsigned int> lind;
+	grskl->getAllNodes(lind);
+
+	for(std::list<unsigned int>::iterator it = lind.begin(); it != lind.end(); it++)
+		FillDisk(shape,grskl->getNode<mathtools::geometry::euclidian::HyperSphere<2> >(*it));
+}
+
+void algorithm::skinning::Filling(shape::RLEShape<2>::Ptr shape, const skeleton::BranchContSkel2d::Ptr contbr, const OptionsFilling &options)
+{
 	for(unsigned int i = 0; i < options.nbcer; i++)
 	{
 		double t = (double)i/(double)(options.nbcer-1);
-		mathtools::geometry::euclidian::HyperSphere<2> sph = contbr->getNode<mathtools::geometry::euclidian::HyperSphere<2> >(t);
-		
-    	cv::circle(im_shape,cv::Point2i(sph.getCenter().getCoords(shape->getFrame()).x()+0.5,sph.getCenter().getCoords(shape->getFrame()).y()+0.5),sph.getRadius(),255,-1);
+		FillDisk(shape,contbr->getNode<mathtools::geometry::euclidian::HyperSphere<2> >(t));
 	}
 }
 
-void algorithm::skinning::Filling(shape::DiscreteShape<2>::Ptr shape, const skeleton::CompContSkel2d::Ptr contskl, const OptionsFilling &options)
+void algorithm::skinning::Filling(shape::RLEShape<2>::Ptr shape, const skeleton::CompContSkel2d::Ptr contskl, const OptionsFilling &options)
 {
 	std::vector<unsigned int> edge(0);
 	contskl->getAllEdges(edge);
@@ -76,7 +226,7 @@ void algorithm::skinning::Filling(shape::DiscreteShape<2>::Ptr shape, const skel
 
 void algorithm::skinning::Filling(shape::DiscreteShape<2>::Ptr shape, const skeleton::GraphProjSkel::Ptr grskl)
 {
-	cv::Mat im_shapetimes2(shape->getHeight()*2,shape->getWidth()*2,CV_8U,cv::Scalar(0));
+	std::vector<cv::RotatedRect> vec_rect(0);
 	
 	std::list<unsigned int> lind;
 	grskl->getAllNodes(lind);
@@ -91,19 +241,15 @@ void algorithm::skinning::Filling(shape::DiscreteShape<2>::Ptr shape, const skel
 							 cv::Size2f(2.0*2.0*ell.getAxes().block<2,1>(0,0).norm(),2.0*2.0*ell.getAxes().block<2,1>(0,1).norm()),
 							 atan2(ell.getAxes()(1,0),ell.getAxes()(0,0))*180/M_PI);
 		
-		cv::ellipse(im_shapetimes2,rect,255,-1);
+		vec_rect.push_back(rect);
 	}
 	
-	cv::Mat imtmp(shape->getHeight(),shape->getWidth(),CV_8U,cv::Scalar(0));
-	cv::resize(im_shapetimes2,imtmp,cv::Size(shape->getWidth(),shape->getHeight()));
-	
-	cv::Mat im_shape(shape->getHeight(),shape->getWidth(),CV_8U,&shape->getContainer()[0]);
-	imtmp.copyTo(im_shape);
+	FillEllipses(shape,vec_rect);
 }
 
 void algorithm::skinning::Filling(shape::DiscreteShape<2>::Ptr shape, const skeleton::BranchContProjSkel::Ptr contbr, const OptionsFilling &options)
 {
-	cv::Mat im_shapetimes2(shape->getHeight()*2,shape->getWidth()*2,CV_8U,cv::Scalar(0));
+	std::vector<cv::RotatedRect> vec_rect(0);
 
 	for(unsigned int i = 0; i < options.nbcer; i++)
 	{
@@ -116,14 +262,10 @@ void algorithm::skinning::Filling(shape::DiscreteShape<2>::Ptr shape, const skel
 							 cv::Size2f(2.0*2.0*ell.getAxes().block<2,1>(0,0).norm(),2.0*2.0*ell.getAxes().block<2,1>(0,1).norm()),
 							 atan2(ell.getAxes()(1,0),ell.getAxes()(0,0))*180/M_PI);
 		
-		cv::ellipse(im_shapetimes2,rect,255,-1);
+		vec_rect.push_back(rect);
 	}
 	
-	cv::Mat imtmp(shape->getHeight(),shape->getWidth(),CV_8U,cv::Scalar(0));
-	cv::resize(im_shapetimes2,imtmp,cv::Size(shape->getWidth(),shape->getHeight()));
-	
-	cv::Mat im_shape(shape->getHeight(),shape->getWidth(),CV_8U,&shape->getContainer()[0]);
-	imtmp.copyTo(im_shape);
+	FillEllipses(shape,vec_rect);
 }
 
 void algorithm::skinning::Filling(shape::DiscreteShape<2>::Ptr shape, const skeleton::CompContProjSkel::Ptr contskl, const OptionsFilling &options)
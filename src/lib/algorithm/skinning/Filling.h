@@ -32,6 +32,7 @@ SOFTWARE.
 
 #include <skeleton/Skeletons.h>
 #include <shape/DiscreteShape.h>
+#include <shape/RLEShape.h>
 
 /**
  *  \brief Lots of algorithms
@@ -87,6 +88,34 @@ namespace algorithm
  		 */
 		void Filling(shape::DiscreteShape<2>::Ptr shape, const skeleton::CompContSkel2d::Ptr contskl, const OptionsFilling &options = OptionsFilling());
 
+		/**
+ 		 *  \brief Computes filling of a run length encoded shape from a graph skeleton
+ 		 *
+		 *  \details Each disk is added as one run per row it covers, with the pixels filled in a discrete shape
+ 		 *
+		 *  \param shape   shape to fill
+ 		 *  \param grskl   graph skeleton to fill
+ 		 */
+		void Filling(shape::RLEShape<2>::Ptr shape, const skeleton::GraphSkel2d::Ptr grskl);
+
+		/**
+ 		 *  \brief Computes filling of a run length encoded shape from a skeleton branch
+ 		 *
+		 *  \param shape   shape to fill
+ 		 *  \param contbr  continuous branch to fill
+ 		 *  \param options filling options
+ 		 */
+		void Filling(shape::RLEShape<2>::Ptr shape, const skeleton::BranchContSkel2d::Ptr contbr, const OptionsFilling &options = OptionsFilling());
+
+		/**
+ 		 *  \brief Computes filling of a run length encoded shape from a skeleton
+ 		 *
+		 *  \param shape   shape to fill
+ 		 *  \param contskl continuous skeleton to fill
+ 		 *  \param options filling options
+ 		 */
+		void Filling(shape::RLEShape<2>::Ptr shape, const skeleton::CompContSkel2d::Ptr contskl, const OptionsFilling &options = OptionsFilling());
+
 		/**
  		 *  \brief Computes filling of a shape from a projective skeletal branch
  		 *
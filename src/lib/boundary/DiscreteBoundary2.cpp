@@ -28,45 +28,98 @@ SOFTWARE.
  */
 
 #include "DiscreteBoundary2.h"
+#include <algorithm>
+#include <stdexcept>
 
 using namespace boundary;
 
-boundary::DiscreteBoundary<2>::DiscreteBoundary(const mathtools::affine::Frame<2>::Ptr frame) : m_frame(frame), m_vecvert(0) {}
+boundary::DiscreteBoundary<2>::DiscreteBoundary(const mathtools::affine::Frame<2>::Ptr frame) : m_frame(frame), m_x(0), m_y(0), m_loop(1,0), m_lastloop(0) {}
+
+boundary::DiscreteBoundary<2>::DiscreteBoundary(const DiscreteBoundary<2> &bnd) :
+	m_frame(bnd.m_frame), m_x(bnd.m_x), m_y(bnd.m_y), m_loop(bnd.m_loop), m_lastloop(0) {}
+
+boundary::DiscreteBoundary<2>& boundary::DiscreteBoundary<2>::operator=(const DiscreteBoundary<2> &bnd)
+{
+	m_frame = bnd.m_frame;
+	m_x = bnd.m_x;
+	m_y = bnd.m_y;
+	m_loop = bnd.m_loop;
+	m_lastloop.store(0,std::memory_order_relaxed);
+	return *this;
+}
 
 const mathtools::affine::Frame<2>::Ptr boundary::DiscreteBoundary<2>::getFrame() const
 {
 	return m_frame;
 }
 
+unsigned int boundary::DiscreteBoundary<2>::getLoop(unsigned int index) const
+{
+	// concurrent walks may overwrite the cached loop, which is always checked before use
+	unsigned int loop = m_lastloop.load(std::memory_order_relaxed);
+	if(loop+1 < m_loop.size() && m_loop[loop] <= index && index < m_loop[loop+1])
+		return loop;
+
+	loop = std::upper_bound(m_loop.begin(),m_loop.end(),index) - m_loop.begin() - 1;
+	m_lastloop.store(loop,std::memory_order_relaxed);
+	return loop;
+}
+
 unsigned int boundary::DiscreteBoundary<2>::getNext(unsigned int index) const
 {
-	std::map<unsigned int,unsigned int>::const_iterator it = m_neigh.find(index);
-	if(it == m_neigh.end())
+	if(index >= m_x.size())
 		throw std::logic_error("boundary::DiscreteBoundary<2>::getNext: index is not in the skeleton");
-	return it->second;
+	if(index+1 == m_x.size())
+		return m_loop[m_loop.size()-2];
+	
+	unsigned int loop = getLoop(index);
+	return index+1 == m_loop[loop+1] ? m_loop[loop] : index+1;
 }
 
 unsigned int boundary::DiscreteBoundary<2>::getPrev(unsigned int index) const
 {
-	std::map<unsigned int,unsigned int>::const_iterator it = m_neigh_prev.find(index);
-	if(it == m_neigh_prev.end())
+	if(index >= m_x.size())
 		throw std::logic_error("boundary::DiscreteBoundary<2>::getPrev: index is not in the skeleton");
-	return it->second;
+	
+	unsigned int loop = getLoop(index);
+	return index == m_loop[loop] ? m_loop[loop+1]-1 : index-1;
 }
 
 mathtools::affine::Point<2> boundary::DiscreteBoundary<2>::getVertex(unsigned int index) const
 {
-	if(index >= m_vecvert.size()) throw std::logic_error("boundary::DiscreteBoundary<2>::getVertex : index out of bounds");
-	return mathtools::affine::Point<2>(m_vecvert[index]);
+	if(index >= m_x.size()) throw std::logic_error("boundary::DiscreteBoundary<2>::getVertex : index out of bounds");
+	return mathtools::affine::Point<2>(Eigen::Vector2d(m_x[index],m_y[index]));
 }
 
 Eigen::Vector2d boundary::DiscreteBoundary<2>::getCoordinates(unsigned int index) const
 {
-	if(index >= m_vecvert.size()) throw std::logic_error("boundary::DiscreteBoundary<2>::getCoordinates : index out of bounds");
-	return m_vecvert[index];
+	if(index >= m_x.size()) throw std::logic_error("boundary::DiscreteBoundary<2>::getCoordinates : index out of bounds");
+	return Eigen::Vector2d(m_x[index],m_y[index]);
+}
+
+boundary::DiscreteBoundary<2>::VerticesView boundary::DiscreteBoundary<2>::getView() const
+{
+	return VerticesView{m_x.data(),m_y.data(),(unsigned int)m_x.size()};
 }
 
 unsigned int boundary::DiscreteBoundary<2>::getNbVertices() const
 {
-	return m_vecvert.size();
+	return m_x.size();
+}
+
+unsigned int boundary::DiscreteBoundary<2>::getNbLoops() const
+{
+	return m_loop.size()-1;
+}
+
+unsigned int boundary::DiscreteBoundary<2>::getLoopBegin(unsigned int loop) const
+{
+	if(loop+1 >= m_loop.size()) throw std::logic_error("boundary::DiscreteBoundary<2>::getLoopBegin : loop out of bounds");
+	return m_loop[loop];
+}
+
+unsigned int boundary::DiscreteBoundary<2>::getLoopEnd(unsigned int loop) const
+{
+	if(loop+1 >= m_loop.size()) throw std::logic_error("boundary::DiscreteBoundary<2>::getLoopEnd : loop out of bounds");
+	return m_loop[loop+1];
 }
@@ -31,8 +31,8 @@ SOFTWARE.
 #define _DISCRETEBOUNDARY2_H_
 
 #include <memory>
+#include <atomic>
 #include <list>
-#include <map>
 #include <vector>
 #include <mathtools/affine/Frame.h>
 #include <mathtools/affine/Point.h>
@@ -55,6 +55,27 @@ namespace boundary
 			 */
 			using Ptr = std::shared_ptr<DiscreteBoundary<2> >;
 
+			/**
+			 *  \brief Contiguous coordinates of vertices, not owning them
+			 */
+			struct VerticesView
+			{
+				/**
+				 *  \brief Abscissas of the vertices
+				 */
+				const double *x;
+
+				/**
+				 *  \brief Ordinates of the vertices
+				 */
+				const double *y;
+
+				/**
+				 *  \brief Number of vertices
+				 */
+				unsigned int size;
+			};
+
 		protected:
 			/**
 			 *  \brief Boundary frame
@@ -62,19 +83,38 @@ namespace boundary
 			typename mathtools::affine::Frame<2>::Ptr m_frame;
 
 			/**
-			 *  \brief Vector of vertices composing the boundary
+			 *  \brief Abscissas of the vertices composing the boundary
 			 */
-			std::vector<Eigen::Vector2d> m_vecvert;
+			std::vector<double> m_x;
 
 			/**
-			 *  \brief Neighbors of each vertex
+			 *  \brief Ordinates of the vertices composing the boundary
 			 */
-			std::map<unsigned int,unsigned int> m_neigh;
+			std::vector<double> m_y;
 
 			/**
-			 *  \brief Previous neighbors of each vertex
+			 *  \brief Index of the first vertex of each loop, followed by the number of vertices
+			 *
+			 *  \details The vertices of a loop are contiguous, each one is followed by the next one, and the last one by the first one
+			 */
+			std::vector<unsigned int> m_loop;
+
+			/**
+			 *  \brief Loop found by the last search, so that walking along a loop does not search again
 			 */
-			std::map<unsigned int,unsigned int> m_neigh_prev;
+			mutable std::atomic<unsigned int> m_lastloop;
+
+			/**
+			 *  \brief Index of the loop containing a vertex
+			 *
+			 *  \details The loop of the previous call is checked first, the offset table is only searched
+			 *           when the vertex belongs to another loop
+			 *
+			 *  \param index vertex index
+			 *
+			 *  \return loop index
+			 */
+			unsigned int getLoop(unsigned int index) const;
 
 		public:
 			/**
@@ -83,6 +123,22 @@ namespace boundary
 			 *  \param frame boundary frame
 			 */
 			DiscreteBoundary<2>(const mathtools::affine::Frame<2>::Ptr frame = mathtools::affine::Frame<2>::CanonicFrame());
+
+			/**
+			 *  \brief Copy constructor
+			 *
+			 *  \param bnd copied boundary
+			 */
+			DiscreteBoundary<2>(const DiscreteBoundary<2> &bnd);
+
+			/**
+			 *  \brief Copy operator
+			 *
+			 *  \param bnd copied boundary
+			 *
+			 *  \return reference to this boundary
+			 */
+			DiscreteBoundary<2>& operator=(const DiscreteBoundary<2> &bnd);
 			
 			/**
 			 *  \brief Adds new string of vertices
@@ -94,18 +150,19 @@ namespace boundary
 			template<typename Container>
 			void addVerticesPoint(const Container &vertstr)
 			{
-				unsigned int ind = m_vecvert.size();
-				m_vecvert.resize(m_vecvert.size() + vertstr.size());
-				unsigned int beg = ind;
+				if(vertstr.size() == 0)
+					return;
+				unsigned int ind = m_x.size();
+				m_x.resize(m_x.size() + vertstr.size());
+				m_y.resize(m_y.size() + vertstr.size());
 				for(typename Container::const_iterator it = vertstr.begin(); it != vertstr.end(); it++)
 				{
-					m_vecvert[ind] = it->getCoords(m_frame);
-					m_neigh[ind] = ind+1;
-					m_neigh_prev[ind+1] = ind;
+					Eigen::Vector2d coords = it->getCoords(m_frame);
+					m_x[ind] = coords.x();
+					m_y[ind] = coords.y();
 					ind++;
 				}
-				m_neigh[ind-1] = beg;
-				m_neigh_prev[beg] = ind-1;
+				m_loop.push_back(ind);
 			}
 
 			/**
@@ -118,18 +175,18 @@ namespace boundary
 			template<typename Container>
 			void addVerticesVector(const Container &vertstr)
 			{
-				unsigned int ind = m_vecvert.size();
-				m_vecvert.resize(m_vecvert.size() + vertstr.size());
-				unsigned int beg = ind;
+				if(vertstr.size() == 0)
+					return;
+				unsigned int ind = m_x.size();
+				m_x.resize(m_x.size() + vertstr.size());
+				m_y.resize(m_y.size() + vertstr.size());
 				for(typename Container::const_iterator it = vertstr.begin(); it != vertstr.end(); it++)
 				{
-					m_vecvert[ind] = *it;
-					m_neigh[ind] = ind+1;
-					m_neigh_prev[ind+1] = ind;
+					m_x[ind] = it->x();
+					m_y[ind] = it->y();
 					ind++;
 				}
-				m_neigh[ind-1] = beg;
-				m_neigh_prev[beg] = ind-1;
+				m_loop.push_back(ind);
 			}
 
 			/**
@@ -148,9 +205,9 @@ namespace boundary
 			template<typename Container>
 			void getVerticesPoint(Container &cont) const
 			{
-				for(unsigned int i=0; i < m_vecvert.size(); i++)
+				for(unsigned int i=0; i < m_x.size(); i++)
 				{
-					cont.push_back(mathtools::affine::Point<2>(m_vecvert[i],m_frame));
+					cont.push_back(mathtools::affine::Point<2>(Eigen::Vector2d(m_x[i],m_y[i]),m_frame));
 				}
 			}
 
@@ -163,7 +220,10 @@ namespace boundary
 			template<typename Container>
 			void getVerticesVector(Container &cont) const
 			{
-				cont.insert(cont.end(),m_vecvert.begin(),m_vecvert.end());
+				for(unsigned int i=0; i < m_x.size(); i++)
+				{
+					cont.push_back(Eigen::Vector2d(m_x[i],m_y[i]));
+				}
 			}
 
 			/**
@@ -202,6 +262,38 @@ namespace boundary
 			 */
 			Eigen::Vector2d getCoordinates(unsigned int index) const;
 
+			/**
+			 *  \brief Number of loops getter
+			 *
+			 *  \return number of loops
+			 */
+			unsigned int getNbLoops() const;
+
+			/**
+			 *  \brief Get index of the first vertex of a loop
+			 *
+			 *  \param loop loop index
+			 *
+			 *  \return index of the first vertex
+			 */
+			unsigned int getLoopBegin(unsigned int loop) const;
+
+			/**
+			 *  \brief Get index following the last vertex of a loop
+			 *
+			 *  \param loop loop index
+			 *
+			 *  \return index following the last vertex
+			 */
+			unsigned int getLoopEnd(unsigned int loop) const;
+
+			/**
+			 *  \brief Contiguous coordinates getter
+			 *
+			 *  \return view on the coordinates of the vertices, valid until vertices are added
+			 */
+			VerticesView getView() const;
+
 			/**
  			 *  \brief Number of vertices getter
  			 *
@@ -32,6 +32,9 @@ SOFTWARE.
 
 #include <vector>
 #include <memory>
+#include <algorithm>
+#include <mutex>
+#include <atomic>
 #include <mathtools/affine/Frame.h>
 #include <mathtools/affine/Point.h>
 
@@ -61,6 +64,64 @@ namespace shape
 			 */
 			using Ptr = std::shared_ptr<DiscreteShape<2> >;
 
+			/**
+			 *  \brief Bounding box of pixels, columns in [cmin,cmax[ and lines in [lmin,lmax[
+			 */
+			struct BoundingBox
+			{
+				/**
+				 *  \brief First column
+				 */
+				unsigned int cmin;
+
+				/**
+				 *  \brief First line
+				 */
+				unsigned int lmin;
+
+				/**
+				 *  \brief Column after the box
+				 */
+				unsigned int cmax;
+
+				/**
+				 *  \brief Line after the box
+				 */
+				unsigned int lmax;
+
+				/**
+				 *  \brief Default constructor, empty box
+				 */
+				BoundingBox(unsigned int cmin_ = 0, unsigned int lmin_ = 0, unsigned int cmax_ = 0, unsigned int lmax_ = 0) :
+					cmin(cmin_), lmin(lmin_), cmax(cmax_), lmax(lmax_) {}
+
+				/**
+				 *  \brief Tests if the box is empty
+				 *
+				 *  \return true if the box contains no pixel
+				 */
+				bool isEmpty() const
+				{
+					return cmin >= cmax || lmin >= lmax;
+				}
+
+				/**
+				 *  \brief Union of two boxes
+				 *
+				 *  \param box box to merge with
+				 *
+				 *  \return smallest box containing both boxes
+				 */
+				BoundingBox merge(const BoundingBox &box) const
+				{
+					if(box.isEmpty())
+						return *this;
+					if(isEmpty())
+						return box;
+					return BoundingBox(std::min(cmin,box.cmin),std::min(lmin,box.lmin),std::max(cmax,box.cmax),std::max(lmax,box.lmax));
+				}
+			};
+
 		protected:
 			/**
 			 *  \brief Shape frame
@@ -68,10 +129,25 @@ namespace shape
 			typename mathtools::affine::Frame<2>::Ptr m_frame;
 
 			/**
-			 *  \brief Vector containing discrete shape data, row wise
+			 *  \brief Vector containing discrete shape data, row wise (empty for a view)
 			 */
 			std::vector<unsigned char> m_disc;
 
+			/**
+			 *  \brief External buffer of a view, null if the shape owns its data
+			 */
+			unsigned char *m_view;
+
+			/**
+			 *  \brief Number of bytes between the starts of two consecutive rows
+			 */
+			std::size_t m_stride;
+
+			/**
+			 *  \brief Keeps the external buffer of a view alive
+			 */
+			std::shared_ptr<const void> m_owner;
+
 			/**
 			 *  \brief Shape width
 			 */
@@ -82,6 +158,21 @@ namespace shape
 			 */
 			unsigned int m_height;
 
+			/**
+			 *  \brief Cached bounding box of the non zero pixels
+			 */
+			mutable BoundingBox m_bbox;
+
+			/**
+			 *  \brief True if the cached bounding box is up to date
+			 */
+			mutable std::atomic<bool> m_bboxvalid;
+
+			/**
+			 *  \brief Serializes the computations of the cached bounding box of this shape
+			 */
+			mutable std::mutex m_bboxmutex;
+
 		public:
 			/**
 			 *  \brief Constructor
@@ -92,6 +183,36 @@ namespace shape
 			 */
 			DiscreteShape<2>(unsigned int width, unsigned int height, const mathtools::affine::Frame<2>::Ptr frame = mathtools::affine::Frame<2>::CanonicFrame());
 
+			/**
+			 *  \brief View constructor, on an external buffer which is not copied
+			 *
+			 *  \details The buffer may be written from outside, invalidateBoundingBox() has to be called then
+			 *
+			 *  \param data   first pixel of the buffer, row wise
+			 *  \param width  width of the discrete shape
+			 *  \param height height of the discrete shape
+			 *  \param stride number of bytes between the starts of two consecutive rows
+			 *  \param owner  object kept alive as long as the view (may be null if the buffer outlives the shape)
+			 *  \param frame  frame of the discrete shape
+			 */
+			DiscreteShape<2>(unsigned char *data, unsigned int width, unsigned int height, std::size_t stride, const std::shared_ptr<const void> &owner = std::shared_ptr<const void>(), const mathtools::affine::Frame<2>::Ptr frame = mathtools::affine::Frame<2>::CanonicFrame());
+
+			/**
+			 *  \brief Copy constructor
+			 *
+			 *  \param dissh copied shape (a copied view is a view on the same buffer)
+			 */
+			DiscreteShape<2>(const DiscreteShape<2> &dissh);
+
+			/**
+			 *  \brief Copy assignment
+			 *
+			 *  \param dissh copied shape (a copied view is a view on the same buffer)
+			 *
+			 *  \return reference on this shape
+			 */
+			DiscreteShape<2>& operator=(const DiscreteShape<2> &dissh);
+
 			/**
 			 *  \brief Test if a point is in the discrete shape
 			 *
@@ -122,19 +243,76 @@ namespace shape
 			 */
 			unsigned int getHeight() const;
 
+			/**
+			 *  \brief Tests if the shape is a view on an external buffer
+			 *
+			 *  \return true if the shape does not own its data
+			 */
+			bool isView() const;
+
 			/**
 			 *  \brief Container getter
 			 *
+			 *  \details Throws if the shape is a view
+			 *
 			 *  \return container of the shape
 			 */
 			const std::vector<unsigned char>& getContainer() const;
 
 			/**
-			 *  \brief Container getter
+			 *  \brief Container getter, to write pixels
+			 *
+			 *  \details Throws if the shape is a view. The bounding box is computed again after this call, as the container may be modified.
+			 *           This is not enough when the reference is kept: pixels written through it after a later call to
+			 *           getBoundingBox() require a call to invalidateBoundingBox().
 			 *
 			 *  \return container of the shape
 			 */
-			std::vector<unsigned char>& getContainer();
+			std::vector<unsigned char>& getWritableContainer();
+
+			/**
+			 *  \brief Data getter, valid for views and owned containers
+			 *
+			 *  \return first pixel of the shape, row l starting at l * getStride()
+			 */
+			const unsigned char* getData() const;
+
+			/**
+			 *  \brief Data getter, to write pixels, valid for views and owned containers
+			 *
+			 *  \details The bounding box is computed again after this call, as the data may be modified.
+			 *           This is not enough when the pointer is kept: pixels written through it after a later call to
+			 *           getBoundingBox() require a call to invalidateBoundingBox().
+			 *
+			 *  \return first pixel of the shape, row l starting at l * getStride()
+			 */
+			unsigned char* getWritableData();
+
+			/**
+			 *  \brief Stride getter
+			 *
+			 *  \return number of bytes between the starts of two consecutive rows
+			 */
+			std::size_t getStride() const;
+
+			/**
+			 *  \brief Bounding box getter
+			 *
+			 *  \details Computed on the first call after a modification of the container, then cached.
+			 *           Concurrent calls on the same shape wait for a single computation,
+			 *           calls on different shapes do not wait for each other.
+			 *
+			 *  \return tight bounding box of the non zero pixels (empty if there is none)
+			 */
+			BoundingBox getBoundingBox() const;
+
+			/**
+			 *  \brief Marks the cached bounding box as outdated
+			 *
+			 *  \details Has to be called after writing pixels through a container, data pointer or external
+			 *           buffer obtained before the last call to getBoundingBox(). Only clears a flag, without locking.
+			 */
+			void invalidateBoundingBox();
 	};
 }
 
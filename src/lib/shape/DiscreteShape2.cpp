@@ -28,13 +28,43 @@ SOFTWARE.
  */
 
 #include "DiscreteShape.h"
+#include <stdexcept>
 
 using namespace shape;
 
 shape::DiscreteShape<2>::DiscreteShape(unsigned int width, unsigned int height, const mathtools::affine::Frame<2>::Ptr frame) :
-	m_frame(frame), m_disc(width*height,0), m_width(width), m_height(height)
+	m_frame(frame), m_disc(width*height,0), m_view(nullptr), m_stride(width), m_owner(), m_width(width), m_height(height), m_bbox(), m_bboxvalid(true)
 {}
 
+shape::DiscreteShape<2>::DiscreteShape(unsigned char *data, unsigned int width, unsigned int height, std::size_t stride, const std::shared_ptr<const void> &owner, const mathtools::affine::Frame<2>::Ptr frame) :
+	m_frame(frame), m_disc(0), m_view(data), m_stride(stride), m_owner(owner), m_width(width), m_height(height), m_bbox(), m_bboxvalid(false)
+{
+	if(stride < width)
+		throw std::logic_error("shape::DiscreteShape<2>::DiscreteShape : stride is smaller than width");
+	if(!data)
+		throw std::logic_error("shape::DiscreteShape<2>::DiscreteShape : null view buffer");
+}
+
+shape::DiscreteShape<2>::DiscreteShape(const DiscreteShape<2> &dissh) :
+	m_frame(dissh.m_frame), m_disc(dissh.m_disc), m_view(dissh.m_view), m_stride(dissh.m_stride), m_owner(dissh.m_owner), m_width(dissh.m_width), m_height(dissh.m_height), m_bbox(), m_bboxvalid(false)
+{}
+
+shape::DiscreteShape<2>& shape::DiscreteShape<2>::operator=(const DiscreteShape<2> &dissh)
+{
+	if(this != &dissh)
+	{
+		m_frame = dissh.m_frame;
+		m_disc = dissh.m_disc;
+		m_view = dissh.m_view;
+		m_stride = dissh.m_stride;
+		m_owner = dissh.m_owner;
+		m_width = dissh.m_width;
+		m_height = dissh.m_height;
+		invalidateBoundingBox();
+	}
+	return *this;
+}
+
 bool shape::DiscreteShape<2>::isIn(const mathtools::affine::Point<2> &point) const
 {
 	Eigen::Vector2d coords = point.getCoords(m_frame);
@@ -43,9 +73,9 @@ bool shape::DiscreteShape<2>::isIn(const mathtools::affine::Point<2> &point) con
 	
 	if(coords.x() >= 0 && coords.y() >= 0 && coords.x() < m_width && coords.y() < m_height)
 	{
-		unsigned int ind = (unsigned int)coords.x() + m_width * (unsigned int)coords.y();
+		std::size_t ind = (unsigned int)coords.x() + m_stride * (unsigned int)coords.y();
 
-		if(m_disc[ind]) isin = true;
+		if(getData()[ind]) isin = true;
 	}
 
 	return isin;
@@ -67,12 +97,74 @@ unsigned int shape::DiscreteShape<2>::getHeight() const
 	return m_height;
 }
 
+bool shape::DiscreteShape<2>::isView() const
+{
+	return m_view != nullptr;
+}
+
 const std::vector<unsigned char>& shape::DiscreteShape<2>::getContainer() const
 {
+	if(m_view)
+		throw std::logic_error("shape::DiscreteShape<2>::getContainer : the shape is a view, use getData");
 	return m_disc;
 }
 
-std::vector<unsigned char>& shape::DiscreteShape<2>::getContainer()
+std::vector<unsigned char>& shape::DiscreteShape<2>::getWritableContainer()
 {
+	if(m_view)
+		throw std::logic_error("shape::DiscreteShape<2>::getWritableContainer : the shape is a view, use getWritableData");
+	invalidateBoundingBox();
 	return m_disc;
 }
+
+const unsigned char* shape::DiscreteShape<2>::getData() const
+{
+	return m_view ? m_view : m_disc.data();
+}
+
+unsigned char* shape::DiscreteShape<2>::getWritableData()
+{
+	invalidateBoundingBox();
+	return m_view ? m_view : m_disc.data();
+}
+
+std::size_t shape::DiscreteShape<2>::getStride() const
+{
+	return m_stride;
+}
+
+shape::DiscreteShape<2>::BoundingBox shape::DiscreteShape<2>::getBoundingBox() const
+{
+	// only the threads evaluating this shape wait for the scan
+	std::lock_guard<std::mutex> lock(m_bboxmutex);
+	if(!m_bboxvalid.exchange(true))
+	{
+		unsigned int cmin = m_width, lmin = m_height, cmax = 0, lmax = 0;
+#pragma omp parallel for reduction(min:cmin,lmin) reduction(max:cmax,lmax)
+		for(unsigned int l = 0; l < m_height; l++)
+		{
+			const unsigned char *row = getData() + m_stride * l;
+			
+			unsigned int cbeg = 0;
+			while(cbeg < m_width && !row[cbeg]) cbeg++;
+			if(cbeg == m_width) continue;
+
+			unsigned int cend = m_width;
+			while(!row[cend-1]) cend--;
+
+			cmin = std::min(cmin,cbeg);
+			cmax = std::max(cmax,cend);
+			lmin = std::min(lmin,l);
+			lmax = std::max(lmax,l+1);
+		}
+
+		m_bbox = cmin < cmax ? BoundingBox(cmin,lmin,cmax,lmax) : BoundingBox();
+	}
+
+	return m_bbox;
+}
+
+void shape::DiscreteShape<2>::invalidateBoundingBox()
+{
+	m_bboxvalid = false;
+}
@@ -0,0 +1,153 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file LabelShape.h
+ *  \brief Defines multi-label discrete shape
+ *  \author Bastien Durix
+ */
+
+#ifndef _LABELSHAPE_H_
+#define _LABELSHAPE_H_
+
+#include <vector>
+#include <memory>
+#include <mathtools/affine/Frame.h>
+#include <mathtools/affine/Point.h>
+#include "DiscreteShape.h"
+
+/**
+ *  \brief Defines shape tools
+ */
+namespace shape
+{
+	/**
+	 *  \brief Multi-label discrete shape
+	 *
+	 *  \tparam Dim espace dimension
+	 */
+	template<unsigned int Dim>
+	class LabelShape
+	{};
+
+	/**
+	 *  \brief Multi-label discrete shape in dimension 2
+	 *
+	 *  \details Each pixel holds an 8 bits label, each label being a discrete shape
+	 */
+	template<>
+	class LabelShape<2>
+	{
+		public:
+			/**
+			 *  \brief Label shape shared pointer
+			 */
+			using Ptr = std::shared_ptr<LabelShape<2> >;
+
+		protected:
+			/**
+			 *  \brief Shape frame
+			 */
+			typename mathtools::affine::Frame<2>::Ptr m_frame;
+
+			/**
+			 *  \brief Vector containing the labels, row wise
+			 */
+			std::vector<unsigned char> m_labels;
+
+			/**
+			 *  \brief Shape width
+			 */
+			unsigned int m_width;
+
+			/**
+			 *  \brief Shape height
+			 */
+			unsigned int m_height;
+
+		public:
+			/**
+			 *  \brief Constructor, every pixel having label 0
+			 *
+			 *  \param width  width of the label shape
+			 *  \param height height of the label shape
+			 *  \param frame  frame of the label shape
+			 */
+			LabelShape<2>(unsigned int width, unsigned int height, const mathtools::affine::Frame<2>::Ptr frame = mathtools::affine::Frame<2>::CanonicFrame());
+
+			/**
+			 *  \brief Label getter
+			 *
+			 *  \param point point where the label is read
+			 *
+			 *  \return label of the pixel containing the point, 0 outside of the image
+			 */
+			unsigned char getLabel(const mathtools::affine::Point<2> &point) const;
+
+			/**
+			 *  \brief Frame getter
+			 *
+			 *  \return frame of the shape
+			 */
+			const typename mathtools::affine::Frame<2>::Ptr getFrame() const;
+
+			/**
+			 *  \brief Width getter
+			 *
+			 *  \return width of the shape
+			 */
+			unsigned int getWidth() const;
+
+			/**
+			 *  \brief Height getter
+			 *
+			 *  \return height of the shape
+			 */
+			unsigned int getHeight() const;
+
+			/**
+			 *  \brief Container getter
+			 *
+			 *  \return labels of the shape, row wise
+			 */
+			const std::vector<unsigned char>& getContainer() const;
+
+			/**
+			 *  \brief Container getter
+			 *
+			 *  \return labels of the shape, row wise
+			 */
+			std::vector<unsigned char>& getContainer();
+
+			/**
+			 *  \brief Discrete shape of one label
+			 *
+			 *  \param label extracted label
+			 *
+			 *  \return discrete shape, 255 on the pixels with this label and 0 elsewhere
+			 */
+			DiscreteShape<2>::Ptr getMask(unsigned char label) const;
+	};
+}
+
+#endif //_LABELSHAPE_H_
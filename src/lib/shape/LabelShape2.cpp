@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file LabelShape2.cpp
+ *  \brief Defines multi-label discrete shape
+ *  \author Bastien Durix
+ */
+
+#include "LabelShape.h"
+
+using namespace shape;
+
+shape::LabelShape<2>::LabelShape(unsigned int width, unsigned int height, const mathtools::affine::Frame<2>::Ptr frame) :
+	m_frame(frame), m_labels((std::size_t)width*height,0), m_width(width), m_height(height)
+{}
+
+unsigned char shape::LabelShape<2>::getLabel(const mathtools::affine::Point<2> &point) const
+{
+	Eigen::Vector2d coords = point.getCoords(m_frame);
+
+	unsigned char label = 0;
+
+	if(coords.x() >= 0 && coords.y() >= 0 && coords.x() < m_width && coords.y() < m_height)
+		label = m_labels[(unsigned int)coords.x() + (std::size_t)m_width * (unsigned int)coords.y()];
+
+	return label;
+}
+
+const typename mathtools::affine::Frame<2>::Ptr shape::LabelShape<2>::getFrame() const
+{
+	return m_frame;
+}
+
+unsigned int shape::LabelShape<2>::getWidth() const
+{
+	return m_width;
+}
+
+unsigned int shape::LabelShape<2>::getHeight() const
+{
+	return m_height;
+}
+
+const std::vector<unsigned char>& shape::LabelShape<2>::getContainer() const
+{
+	return m_labels;
+}
+
+std::vector<unsigned char>& shape::LabelShape<2>::getContainer()
+{
+	return m_labels;
+}
+
+DiscreteShape<2>::Ptr shape::LabelShape<2>::getMask(unsigned char label) const
+{
+	DiscreteShape<2>::Ptr dissh(new DiscreteShape<2>(m_width,m_height,m_frame));
+	std::vector<unsigned char> &disc = dissh->getWritableContainer();
+
+#pragma omp parallel for
+	for(unsigned int l = 0; l < m_height; l++)
+		for(unsigned int c = 0; c < m_width; c++)
+			disc[c + (std::size_t)m_width * l] = m_labels[c + (std::size_t)m_width * l] == label ? 255 : 0;
+
+	return dissh;
+}
@@ -0,0 +1,256 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file PackedShape.h
+ *  \brief Defines bit packed discrete shape
+ *  \author Bastien Durix
+ */
+
+#ifndef _PACKEDSHAPE_H_
+#define _PACKEDSHAPE_H_
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <mathtools/affine/Frame.h>
+#include <mathtools/affine/Point.h>
+#include "DiscreteShape.h"
+
+/**
+ *  \brief Defines shape tools
+ */
+namespace shape
+{
+	/**
+	 *  \brief Number of set bits in a word
+	 *
+	 *  \param word word to count
+	 *
+	 *  \return number of bits equal to one
+	 */
+	inline unsigned int PopCount(uint64_t word)
+	{
+#if defined(__GNUC__)
+		return __builtin_popcountll(word);
+#else
+		word = word - ((word >> 1) & 0x5555555555555555ULL);
+		word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+		word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		return (unsigned int)((word * 0x0101010101010101ULL) >> 56);
+#endif
+	}
+
+	/**
+	 *  \brief Bit packed discrete shape
+	 *
+	 *  \tparam Dim espace dimension
+	 */
+	template<unsigned int Dim>
+	class PackedShape
+	{};
+
+	/**
+	 *  \brief Bit packed discrete shape in dimension 2
+	 *
+	 *  \details One bit per pixel, in 64 bits words. Each row starts on a new word,
+	 *           and the padding bits at the end of the rows are always zero.
+	 */
+	template<>
+	class PackedShape<2>
+	{
+		public:
+			/**
+			 *  \brief Packed shape shared pointer
+			 */
+			using Ptr = std::shared_ptr<PackedShape<2> >;
+
+		protected:
+			/**
+			 *  \brief Shape frame
+			 */
+			typename mathtools::affine::Frame<2>::Ptr m_frame;
+
+			/**
+			 *  \brief Vector containing packed shape data, row wise, pixel c of a row being bit c%64 of word c/64
+			 */
+			std::vector<uint64_t> m_words;
+
+			/**
+			 *  \brief External words of a view, null if the shape owns its data
+			 */
+			uint64_t *m_view;
+
+			/**
+			 *  \brief Keeps the external words of a view alive
+			 */
+			std::shared_ptr<const void> m_owner;
+
+			/**
+			 *  \brief Shape width
+			 */
+			unsigned int m_width;
+
+			/**
+			 *  \brief Shape height
+			 */
+			unsigned int m_height;
+
+			/**
+			 *  \brief Number of words per row
+			 */
+			unsigned int m_rowwords;
+
+		public:
+			/**
+			 *  \brief Constructor
+			 *
+			 *  \param width  width of the packed shape
+			 *  \param height height of the packed shape
+			 *  \param frame  frame of the packed shape
+			 */
+			PackedShape<2>(unsigned int width, unsigned int height, const mathtools::affine::Frame<2>::Ptr frame = mathtools::affine::Frame<2>::CanonicFrame());
+
+			/**
+			 *  \brief Constructor, packing a discrete shape
+			 *
+			 *  \param dissh discrete shape to pack (non zero pixels are in the shape)
+			 */
+			PackedShape<2>(const DiscreteShape<2>::Ptr dissh);
+
+			/**
+			 *  \brief View constructor, on external words which are not copied
+			 *
+			 *  \param data   first word of the shape, laid out as the container (padding bits must be zero)
+			 *  \param width  width of the packed shape
+			 *  \param height height of the packed shape
+			 *  \param owner  object kept alive as long as the view (may be null if the words outlive the shape)
+			 *  \param frame  frame of the packed shape
+			 */
+			PackedShape<2>(uint64_t *data, unsigned int width, unsigned int height, const std::shared_ptr<const void> &owner = std::shared_ptr<const void>(), const mathtools::affine::Frame<2>::Ptr frame = mathtools::affine::Frame<2>::CanonicFrame());
+
+			/**
+			 *  \brief Test if a point is in the packed shape
+			 *
+			 *  \param point point to test
+			 *
+			 *  \return true is the point is in the packed shape
+			 */
+			virtual bool isIn(const mathtools::affine::Point<2> &point) const;
+
+			/**
+			 *  \brief Pixel getter
+			 *
+			 *  \param c column of the pixel
+			 *  \param l row of the pixel
+			 *
+			 *  \return true if the pixel is in the shape
+			 */
+			bool getPixel(unsigned int c, unsigned int l) const;
+
+			/**
+			 *  \brief Pixel setter
+			 *
+			 *  \param c   column of the pixel
+			 *  \param l   row of the pixel
+			 *  \param val true to add the pixel to the shape
+			 */
+			void setPixel(unsigned int c, unsigned int l, bool val);
+
+			/**
+			 *  \brief Unpacks the shape
+			 *
+			 *  \return discrete shape, with pixels in the shape set to 255
+			 */
+			DiscreteShape<2>::Ptr unpack() const;
+
+			/**
+			 *  \brief Frame getter
+			 *
+			 *  \return frame of the shape
+			 */
+			const typename mathtools::affine::Frame<2>::Ptr getFrame() const;
+
+			/**
+			 *  \brief Width getter
+			 *
+			 *  \return width of the shape
+			 */
+			unsigned int getWidth() const;
+
+			/**
+			 *  \brief Height getter
+			 *
+			 *  \return height of the shape
+			 */
+			unsigned int getHeight() const;
+
+			/**
+			 *  \brief Number of words per row getter
+			 *
+			 *  \return number of words per row
+			 */
+			unsigned int getRowWords() const;
+
+			/**
+			 *  \brief Tests if the shape is a view on external words
+			 *
+			 *  \return true if the shape does not own its data
+			 */
+			bool isView() const;
+
+			/**
+			 *  \brief Container getter
+			 *
+			 *  \details Throws if the shape is a view
+			 *
+			 *  \return container of the shape
+			 */
+			const std::vector<uint64_t>& getContainer() const;
+
+			/**
+			 *  \brief Container getter
+			 *
+			 *  \details Throws if the shape is a view
+			 *
+			 *  \return container of the shape
+			 */
+			std::vector<uint64_t>& getContainer();
+
+			/**
+			 *  \brief Data getter, valid for views and owned containers
+			 *
+			 *  \return first word of the shape, row l starting at word l * getRowWords()
+			 */
+			const uint64_t* getData() const;
+
+			/**
+			 *  \brief Data getter, valid for views and owned containers
+			 *
+			 *  \return first word of the shape, row l starting at word l * getRowWords()
+			 */
+			uint64_t* getData();
+	};
+}
+
+#endif //_PACKEDSHAPE_H_
@@ -0,0 +1,155 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file PackedShape2.cpp
+ *  \brief Defines bit packed discrete shape in dimension 2
+ *  \author Bastien Durix
+ */
+
+#include "PackedShape.h"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace shape;
+
+shape::PackedShape<2>::PackedShape(unsigned int width, unsigned int height, const mathtools::affine::Frame<2>::Ptr frame) :
+	m_frame(frame), m_words(((width+63)/64)*height,0), m_view(nullptr), m_owner(), m_width(width), m_height(height), m_rowwords((width+63)/64)
+{}
+
+shape::PackedShape<2>::PackedShape(uint64_t *data, unsigned int width, unsigned int height, const std::shared_ptr<const void> &owner, const mathtools::affine::Frame<2>::Ptr frame) :
+	m_frame(frame), m_words(0), m_view(data), m_owner(owner), m_width(width), m_height(height), m_rowwords((width+63)/64)
+{
+	if(!data)
+		throw std::logic_error("shape::PackedShape<2>::PackedShape : null view buffer");
+}
+
+shape::PackedShape<2>::PackedShape(const DiscreteShape<2>::Ptr dissh) :
+	PackedShape(dissh->getWidth(),dissh->getHeight(),dissh->getFrame())
+{
+	const shape::DiscreteShape<2> &shp = *dissh;
+	const unsigned char *disc = shp.getData();
+	const std::size_t stride = shp.getStride();
+#pragma omp parallel for
+	for(unsigned int l = 0; l < m_height; l++)
+	{
+		const unsigned char *row = disc + stride * l;
+		uint64_t *rowwords = &m_words[m_rowwords * l];
+		for(unsigned int w = 0; w < m_rowwords; w++)
+		{
+			uint64_t word = 0;
+			unsigned int nbbits = std::min(m_width - 64*w, 64u);
+			for(unsigned int b = 0; b < nbbits; b++)
+				word |= (uint64_t)(row[64*w + b] != 0) << b;
+			rowwords[w] = word;
+		}
+	}
+}
+
+bool shape::PackedShape<2>::isIn(const mathtools::affine::Point<2> &point) const
+{
+	Eigen::Vector2d coords = point.getCoords(m_frame);
+	
+	bool isin=false;
+	
+	if(coords.x() >= 0 && coords.y() >= 0 && coords.x() < m_width && coords.y() < m_height)
+		isin = getPixel((unsigned int)coords.x(),(unsigned int)coords.y());
+
+	return isin;
+}
+
+bool shape::PackedShape<2>::getPixel(unsigned int c, unsigned int l) const
+{
+	return (getData()[(std::size_t)m_rowwords * l + c/64] >> (c%64)) & 1;
+}
+
+void shape::PackedShape<2>::setPixel(unsigned int c, unsigned int l, bool val)
+{
+	uint64_t mask = (uint64_t)1 << (c%64);
+	uint64_t &word = getData()[(std::size_t)m_rowwords * l + c/64];
+	if(val)
+		word |= mask;
+	else
+		word &= ~mask;
+}
+
+DiscreteShape<2>::Ptr shape::PackedShape<2>::unpack() const
+{
+	DiscreteShape<2>::Ptr dissh(new DiscreteShape<2>(m_width,m_height,m_frame));
+	std::vector<unsigned char> &disc = dissh->getWritableContainer();
+#pragma omp parallel for
+	for(unsigned int l = 0; l < m_height; l++)
+		for(unsigned int c = 0; c < m_width; c++)
+			if(getPixel(c,l))
+				disc[c + m_width * l] = 255;
+	return dissh;
+}
+
+const typename mathtools::affine::Frame<2>::Ptr shape::PackedShape<2>::getFrame() const
+{
+	return m_frame;
+}
+
+unsigned int shape::PackedShape<2>::getWidth() const
+{
+	return m_width;
+}
+
+unsigned int shape::PackedShape<2>::getHeight() const
+{
+	return m_height;
+}
+
+unsigned int shape::PackedShape<2>::getRowWords() const
+{
+	return m_rowwords;
+}
+
+bool shape::PackedShape<2>::isView() const
+{
+	return m_view != nullptr;
+}
+
+const std::vector<uint64_t>& shape::PackedShape<2>::getContainer() const
+{
+	if(m_view)
+		throw std::logic_error("shape::PackedShape<2>::getContainer : the shape is a view, use getData");
+	return m_words;
+}
+
+std::vector<uint64_t>& shape::PackedShape<2>::getContainer()
+{
+	if(m_view)
+		throw std::logic_error("shape::PackedShape<2>::getContainer : the shape is a view, use getData");
+	return m_words;
+}
+
+const uint64_t* shape::PackedShape<2>::getData() const
+{
+	return m_view ? m_view : m_words.data();
+}
+
+uint64_t* shape::PackedShape<2>::getData()
+{
+	return m_view ? m_view : m_words.data();
+}
@@ -0,0 +1,195 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file RLEShape.h
+ *  \brief Defines run length encoded discrete shapes
+ *  \author Bastien Durix
+ */
+
+#ifndef _RLESHAPE_H_
+#define _RLESHAPE_H_
+
+#include <vector>
+#include <memory>
+#include <mathtools/affine/Frame.h>
+#include <mathtools/affine/Point.h>
+#include "DiscreteShape.h"
+
+/**
+ *  \brief Defines shape tools
+ */
+namespace shape
+{
+	/**
+	 *  \brief Run length encoded discrete shape
+	 *
+	 *  \tparam Dim espace dimension
+	 */
+	template<unsigned int Dim>
+	class RLEShape
+	{};
+
+	/**
+	 *  \brief Run length encoded discrete shape in dimension 2
+	 *
+	 *  \details Each row holds its runs of pixels in the shape, sorted, disjoint and not touching each other
+	 */
+	template<>
+	class RLEShape<2>
+	{
+		public:
+			/**
+			 *  \brief RLE shape shared pointer
+			 */
+			using Ptr = std::shared_ptr<RLEShape<2> >;
+
+			/**
+			 *  \brief Run of consecutive pixels of a row
+			 */
+			struct Run
+			{
+				/**
+				 *  \brief First column of the run
+				 */
+				unsigned int beg;
+
+				/**
+				 *  \brief Column after the run
+				 */
+				unsigned int end;
+			};
+
+		protected:
+			/**
+			 *  \brief Shape frame
+			 */
+			typename mathtools::affine::Frame<2>::Ptr m_frame;
+
+			/**
+			 *  \brief Runs of each row
+			 */
+			std::vector<std::vector<Run> > m_rows;
+
+			/**
+			 *  \brief Shape width
+			 */
+			unsigned int m_width;
+
+			/**
+			 *  \brief Shape height
+			 */
+			unsigned int m_height;
+
+		public:
+			/**
+			 *  \brief Constructor
+			 *
+			 *  \param width  width of the shape
+			 *  \param height height of the shape
+			 *  \param frame  frame of the shape
+			 */
+			RLEShape<2>(unsigned int width, unsigned int height, const mathtools::affine::Frame<2>::Ptr frame = mathtools::affine::Frame<2>::CanonicFrame());
+
+			/**
+			 *  \brief Constructor, encoding a discrete shape
+			 *
+			 *  \param dissh discrete shape to encode (non zero pixels are in the shape)
+			 */
+			RLEShape<2>(const DiscreteShape<2>::Ptr dissh);
+
+			/**
+			 *  \brief Test if a point is in the shape
+			 *
+			 *  \param point point to test
+			 *
+			 *  \return true is the point is in the shape
+			 */
+			virtual bool isIn(const mathtools::affine::Point<2> &point) const;
+
+			/**
+			 *  \brief Pixel getter
+			 *
+			 *  \param c column of the pixel
+			 *  \param l row of the pixel
+			 *
+			 *  \return true if the pixel is in the shape
+			 */
+			bool getPixel(unsigned int c, unsigned int l) const;
+
+			/**
+			 *  \brief Adds a run of pixels to the shape, merging it with the runs it overlaps or touches
+			 *
+			 *  \param l   row of the run
+			 *  \param beg first column of the run
+			 *  \param end column after the run
+			 */
+			void addRun(unsigned int l, unsigned int beg, unsigned int end);
+
+			/**
+			 *  \brief Decodes the shape
+			 *
+			 *  \return discrete shape, with pixels in the shape set to 255
+			 */
+			DiscreteShape<2>::Ptr unpack() const;
+
+			/**
+			 *  \brief Frame getter
+			 *
+			 *  \return frame of the shape
+			 */
+			const typename mathtools::affine::Frame<2>::Ptr getFrame() const;
+
+			/**
+			 *  \brief Width getter
+			 *
+			 *  \return width of the shape
+			 */
+			unsigned int getWidth() const;
+
+			/**
+			 *  \brief Height getter
+			 *
+			 *  \return height of the shape
+			 */
+			unsigned int getHeight() const;
+
+			/**
+			 *  \brief Runs of a row getter
+			 *
+			 *  \param l row
+			 *
+			 *  \return runs of the row, sorted
+			 */
+			const std::vector<Run>& getRow(unsigned int l) const;
+
+			/**
+			 *  \brief Area getter
+			 *
+			 *  \return number of pixels in the shape
+			 */
+			unsigned long long getArea() const;
+	};
+}
+
+#endif //_RLESHAPE_H_
@@ -0,0 +1,150 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file RLEShape2.cpp
+ *  \brief Defines run length encoded discrete shapes
+ *  \author Bastien Durix
+ */
+
+#include "RLEShape.h"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace shape;
+
+shape::RLEShape<2>::RLEShape(unsigned int width, unsigned int height, const mathtools::affine::Frame<2>::Ptr frame) :
+	m_frame(frame), m_rows(height), m_width(width), m_height(height)
+{}
+
+shape::RLEShape<2>::RLEShape(const DiscreteShape<2>::Ptr dissh) :
+	RLEShape(dissh->getWidth(),dissh->getHeight(),dissh->getFrame())
+{
+	const shape::DiscreteShape<2> &shp = *dissh;
+	const unsigned char *disc = shp.getData();
+	const std::size_t stride = shp.getStride();
+#pragma omp parallel for
+	for(unsigned int l = 0; l < m_height; l++)
+	{
+		const unsigned char *row = disc + stride * l;
+		std::vector<Run> &runs = m_rows[l];
+		for(unsigned int c = 0; c < m_width; c++)
+		{
+			if(row[c])
+			{
+				unsigned int beg = c;
+				while(c < m_width && row[c])
+					c++;
+				runs.push_back(Run{beg,c});
+			}
+		}
+	}
+}
+
+bool shape::RLEShape<2>::isIn(const mathtools::affine::Point<2> &point) const
+{
+	Eigen::Vector2d coords = point.getCoords(m_frame);
+	
+	bool isin=false;
+	
+	if(coords.x() >= 0 && coords.y() >= 0 && coords.x() < m_width && coords.y() < m_height)
+		isin = getPixel((unsigned int)coords.x(),(unsigned int)coords.y());
+
+	return isin;
+}
+
+bool shape::RLEShape<2>::getPixel(unsigned int c, unsigned int l) const
+{
+	const std::vector<Run> &runs = m_rows[l];
+	
+	// first run ending after the pixel
+	std::vector<Run>::const_iterator it = std::upper_bound(runs.begin(),runs.end(),c,[](unsigned int col, const Run &run){ return col < run.end; });
+	return it != runs.end() && it->beg <= c;
+}
+
+void shape::RLEShape<2>::addRun(unsigned int l, unsigned int beg, unsigned int end)
+{
+	if(l >= m_height || end > m_width)
+		throw std::logic_error("shape::RLEShape<2>::addRun : run out of the shape");
+	if(beg >= end)
+		return;
+
+	std::vector<Run> &runs = m_rows[l];
+	
+	// runs overlapping or touching the new one
+	std::vector<Run>::iterator first = std::lower_bound(runs.begin(),runs.end(),beg,[](const Run &run, unsigned int col){ return run.end < col; });
+	std::vector<Run>::iterator last = first;
+	while(last != runs.end() && last->beg <= end)
+		last++;
+	
+	if(first != last)
+	{
+		beg = std::min(beg,first->beg);
+		end = std::max(end,(last-1)->end);
+		*first = Run{beg,end};
+		runs.erase(first+1,last);
+	}
+	else
+		runs.insert(first,Run{beg,end});
+}
+
+DiscreteShape<2>::Ptr shape::RLEShape<2>::unpack() const
+{
+	DiscreteShape<2>::Ptr dissh(new DiscreteShape<2>(m_width,m_height,m_frame));
+	std::vector<unsigned char> &disc = dissh->getWritableContainer();
+#pragma omp parallel for
+	for(unsigned int l = 0; l < m_height; l++)
+		for(unsigned int i = 0; i < m_rows[l].size(); i++)
+			std::fill(disc.begin() + m_width * l + m_rows[l][i].beg, disc.begin() + m_width * l + m_rows[l][i].end, 255);
+	return dissh;
+}
+
+const typename mathtools::affine::Frame<2>::Ptr shape::RLEShape<2>::getFrame() const
+{
+	return m_frame;
+}
+
+unsigned int shape::RLEShape<2>::getWidth() const
+{
+	return m_width;
+}
+
+unsigned int shape::RLEShape<2>::getHeight() const
+{
+	return m_height;
+}
+
+const std::vector<RLEShape<2>::Run>& shape::RLEShape<2>::getRow(unsigned int l) const
+{
+	return m_rows[l];
+}
+
+unsigned long long shape::RLEShape<2>::getArea() const
+{
+	unsigned long long area = 0;
+#pragma omp parallel for reduction(+:area)
+	for(unsigned int l = 0; l < m_height; l++)
+		for(unsigned int i = 0; i < m_rows[l].size(); i++)
+			area += m_rows[l][i].end - m_rows[l][i].beg;
+	return area;
+}
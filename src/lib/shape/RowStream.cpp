@@ -0,0 +1,59 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file RowStream.cpp
+ *  \brief Defines streams of shape rows
+ *  \author Bastien Durix
+ */
+
+#include "RowStream.h"
+#include <cstring>
+#include <stdexcept>
+
+shape::RowStream::~RowStream()
+{}
+
+shape::DiscreteRowStream::DiscreteRowStream(const DiscreteShape<2>::Ptr dissh) :
+	m_shape(dissh), m_row(0)
+{}
+
+unsigned int shape::DiscreteRowStream::getWidth() const
+{
+	return m_shape->getWidth();
+}
+
+unsigned int shape::DiscreteRowStream::getHeight() const
+{
+	return m_shape->getHeight();
+}
+
+void shape::DiscreteRowStream::readRow(unsigned char *row)
+{
+	const DiscreteShape<2> &shp = *m_shape;
+	if(m_row >= shp.getHeight())
+		throw std::logic_error("shape::DiscreteRowStream::readRow : no row left");
+
+	std::memcpy(row,shp.getData() + shp.getStride() * m_row,shp.getWidth());
+	m_row++;
+}
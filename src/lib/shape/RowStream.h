@@ -0,0 +1,129 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file RowStream.h
+ *  \brief Defines streams of shape rows
+ *  \author Bastien Durix
+ */
+
+#ifndef _ROWSTREAM_H_
+#define _ROWSTREAM_H_
+
+#include <memory>
+#include "DiscreteShape.h"
+
+/**
+ *  \brief Defines shape tools
+ */
+namespace shape
+{
+	/**
+	 *  \brief Stream of the rows of a two dimensional shape
+	 *
+	 *  \details Rows are read once, from top to bottom, so that shapes too large
+	 *           to be held in memory can be processed band by band
+	 */
+	class RowStream
+	{
+		public:
+			/**
+			 *  \brief Row stream shared pointer
+			 */
+			using Ptr = std::shared_ptr<RowStream>;
+
+			/**
+			 *  \brief Destructor
+			 */
+			virtual ~RowStream();
+
+			/**
+			 *  \brief Width getter
+			 *
+			 *  \return width of the shape
+			 */
+			virtual unsigned int getWidth() const = 0;
+
+			/**
+			 *  \brief Height getter
+			 *
+			 *  \return height of the shape
+			 */
+			virtual unsigned int getHeight() const = 0;
+
+			/**
+			 *  \brief Reads the next row
+			 *
+			 *  \param row pixels of the row, of size getWidth(), non zero in the shape
+			 */
+			virtual void readRow(unsigned char *row) = 0;
+	};
+
+	/**
+	 *  \brief Stream of the rows of a discrete shape
+	 */
+	class DiscreteRowStream : public RowStream
+	{
+		protected:
+			/**
+			 *  \brief Streamed shape
+			 */
+			DiscreteShape<2>::Ptr m_shape;
+
+			/**
+			 *  \brief Next row to read
+			 */
+			unsigned int m_row;
+
+		public:
+			/**
+			 *  \brief Constructor
+			 *
+			 *  \param dissh streamed shape (possibly a view)
+			 */
+			DiscreteRowStream(const DiscreteShape<2>::Ptr dissh);
+
+			/**
+			 *  \brief Width getter
+			 *
+			 *  \return width of the shape
+			 */
+			unsigned int getWidth() const;
+
+			/**
+			 *  \brief Height getter
+			 *
+			 *  \return height of the shape
+			 */
+			unsigned int getHeight() const;
+
+			/**
+			 *  \brief Reads the next row
+			 *
+			 *  \param row pixels of the row, of size getWidth(), non zero in the shape
+			 */
+			void readRow(unsigned char *row);
+	};
+}
+
+#endif //_ROWSTREAM_H_
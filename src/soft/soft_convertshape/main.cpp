@@ -0,0 +1,124 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file main.cpp
+ *  \brief Converts binary images to native mask files
+ *  \author Bastien Durix
+ */
+
+#include <boost/program_options.hpp>
+
+#include <iostream>
+#include <sys/stat.h>
+
+#include <shape/DiscreteShape.h>
+#include <shape/PackedShape.h>
+
+#include <fileio/ShapeFile.h>
+#include <fileio/MaskFile.h>
+
+int main(int argc, char** argv)
+{
+	std::string input, output, encoding;
+	unsigned int threshold;
+
+	boost::program_options::options_description desc("OPTIONS");
+	
+	desc.add_options()
+		("help", "Help message")
+		("input", boost::program_options::value<std::string>(&input)->default_value("img.png"), "Input binary image file (PBM, PGM, PNG or mask file)")
+		("output", boost::program_options::value<std::string>(&output)->default_value("img.msk"), "Output mask file")
+		("encoding", boost::program_options::value<std::string>(&encoding)->default_value("packed"), "Pixels encoding of the mask file (bytes or packed)")
+		("threshold", boost::program_options::value<unsigned int>(&threshold)->default_value(1), "Pixels of an image strictly above the threshold are in the shape")
+		;
+	
+	boost::program_options::variables_map vm;
+	boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc), vm);
+	boost::program_options::notify(vm);
+	
+	if (vm.count("help")) {
+		std::cout << desc << std::endl;
+		return 0;
+	}
+
+	if(encoding != "bytes" && encoding != "packed")
+	{
+		std::cerr << "Unknown encoding " << encoding << std::endl;
+		return 1;
+	}
+	if(threshold > 255)
+	{
+		std::cerr << "The threshold has to be in [0,255]" << std::endl;
+		return 1;
+	}
+
+	// the input may be mapped while the output is written: writing in place would truncate it
+	struct stat instat, outstat;
+	if(stat(input.c_str(),&instat) == 0 && stat(output.c_str(),&outstat) == 0 &&
+	   instat.st_dev == outstat.st_dev && instat.st_ino == outstat.st_ino)
+	{
+		std::cerr << "The output file has to be different from the input file" << std::endl;
+		return 1;
+	}
+
+	fileio::MaskEncoding inencoding;
+	bool inmask = fileio::GetMaskEncoding(input,inencoding);
+
+	if(encoding == "packed")
+	{
+		shape::PackedShape<2>::Ptr packsh;
+		if(!inmask)
+			packsh = fileio::ReadPackedShape(input,fileio::OptionsReadShape(threshold));
+		else if(inencoding == fileio::MaskEncoding::packed)
+			packsh = fileio::MapPackedMaskFile(input);
+		else
+			packsh = shape::PackedShape<2>::Ptr(new shape::PackedShape<2>(fileio::MapMaskFile(input)));
+
+		if(!packsh)
+		{
+			std::cerr << "Cannot read " << input << std::endl;
+			return 1;
+		}
+		fileio::WriteMaskFile(packsh,output);
+	}
+	else
+	{
+		shape::DiscreteShape<2>::Ptr dissh;
+		if(!inmask)
+			dissh = fileio::ReadShape(input,fileio::OptionsReadShape(threshold));
+		else if(inencoding == fileio::MaskEncoding::packed)
+			dissh = fileio::MapPackedMaskFile(input)->unpack();
+		else
+			dissh = fileio::MapMaskFile(input);
+
+		if(!dissh)
+		{
+			std::cerr << "Cannot read " << input << std::endl;
+			return 1;
+		}
+		fileio::WriteMaskFile(dissh,output,fileio::MaskEncoding::bytes);
+	}
+
+	return 0;
+}
@@ -28,27 +28,38 @@ SOFTWARE.
 
 #include <boost/program_options.hpp>
 
-#include <opencv2/core/core.hpp>
-#include <opencv2/highgui/highgui.hpp>
-#include <opencv2/imgproc/imgproc.hpp>
-#include <opencv2/imgcodecs/imgcodecs.hpp>
+#include <algorithm>
 
 #include <shape/DiscreteShape.h>
 #include <boundary/DiscreteBoundary.h>
 
 #include <algorithm/extractboundary/NaiveBoundary.h>
 #include <algorithm/evaluation/ShapeError.h>
+#include <algorithm/evaluation/ReferenceShape.h>
+#include <algorithm/evaluation/StreamError.h>
+#include <algorithm/evaluation/LabelError.h>
+#include <algorithm/evaluation/MetricSet.h>
+
+#include <fileio/ShapeFile.h>
 
 int main(int argc, char** argv)
 {
-	std::string imgref, imgcmp;
+	std::string imgref;
+	std::vector<std::string> vecimgcmp, vecmetric;
+	unsigned int bandheight, batchsize;
 
 	boost::program_options::options_description desc("OPTIONS");
 	
 	desc.add_options()
 		("help", "Help message")
 		("imgref", boost::program_options::value<std::string>(&imgref)->default_value("img1.png"), "Reference binary image file")
-		("imgcmp", boost::program_options::value<std::string>(&imgcmp)->default_value("img2.png"), "Compaired binary image file")
+		("imgcmp", boost::program_options::value<std::vector<std::string> >(&vecimgcmp)->multitoken()->default_value(std::vector<std::string>(1,"img2.png"),"img2.png"), "Compaired binary image files")
+		("stream", "Reads the images band by band, without loading them (for very large images)")
+		("labels", "Evaluates each label of the images (gray levels), 0 being the background")
+		("bandheight", boost::program_options::value<unsigned int>(&bandheight)->default_value(256), "Number of rows per band, in stream mode")
+		("metrics", boost::program_options::value<std::vector<std::string> >(&vecmetric)->multitoken(), "Computes the given metrics in a single pass over the images (iou, dice, symdiff, hausdist, avgsurfdist). "
+				 "Distances are measured between the boundary pixels, not between the pixel corners of the default Hausdorff distance")
+		("batchsize", boost::program_options::value<unsigned int>(&batchsize)->default_value(16), "Number of compared images loaded and evaluated together")
 		;
 	
 	boost::program_options::variables_map vm;
@@ -60,26 +71,171 @@ int main(int argc, char** argv)
 		return 0;
 	}
 
-	cv::Mat shprefgray = cv::imread(imgref,cv::ImreadModes::IMREAD_GRAYSCALE);
-	cv::Mat shpref;
-	cv::threshold(shprefgray,shpref,1,255,cv::THRESH_BINARY);
-	shape::DiscreteShape<2>::Ptr disshref = shape::DiscreteShape<2>::Ptr(new shape::DiscreteShape<2>(shpref.cols,shpref.rows));
+	if(batchsize == 0)
+	{
+		std::cerr << "The batch size has to be positive" << std::endl;
+		return 1;
+	}
 
-	cv::Mat shpcmpgray = cv::imread(imgcmp,cv::ImreadModes::IMREAD_GRAYSCALE);
-	cv::Mat shpcmp;
-	cv::threshold(shpcmpgray,shpcmp,1,255,cv::THRESH_BINARY);
-	shape::DiscreteShape<2>::Ptr disshcmp = shape::DiscreteShape<2>::Ptr(new shape::DiscreteShape<2>(shpcmp.cols,shpcmp.rows));
-	
-	double symdiff = algorithm::evaluation::SymDiffArea(disshref,disshcmp);
+	unsigned int metrics = 0;
+	for(unsigned int i = 0; i < vecmetric.size(); i++)
+	{
+		if(vecmetric[i] == "iou")
+			metrics |= algorithm::evaluation::MetricSet::iou;
+		else if(vecmetric[i] == "dice")
+			metrics |= algorithm::evaluation::MetricSet::dice;
+		else if(vecmetric[i] == "symdiff")
+			metrics |= algorithm::evaluation::MetricSet::symdiff;
+		else if(vecmetric[i] == "hausdist")
+			metrics |= algorithm::evaluation::MetricSet::hausdist;
+		else if(vecmetric[i] == "avgsurfdist")
+			metrics |= algorithm::evaluation::MetricSet::avgsurfdist;
+		else
+		{
+			std::cerr << "Unknown metric " << vecmetric[i] << std::endl;
+			return 1;
+		}
+	}
+
+	if(vm.count("labels"))
+	{
+		shape::LabelShape<2>::Ptr labshref = fileio::ReadLabelShape(imgref);
+		if(!labshref)
+		{
+			std::cerr << "Cannot read " << imgref << std::endl;
+			return 1;
+		}
+
+		for(unsigned int i = 0; i < vecimgcmp.size(); i++)
+		{
+			shape::LabelShape<2>::Ptr labshcmp = fileio::ReadLabelShape(vecimgcmp[i]);
+			if(!labshcmp)
+			{
+				std::cerr << "Cannot read " << vecimgcmp[i] << std::endl;
+				return 1;
+			}
+
+			std::vector<algorithm::evaluation::LabelErrors> vecerr = algorithm::evaluation::LabelError(labshref,labshcmp);
+
+			if(vecimgcmp.size() > 1)
+				std::cout << vecimgcmp[i] << std::endl;
+
+			for(unsigned int j = 0; j < vecerr.size(); j++)
+			{
+				std::cout << "Label " << (unsigned int)vecerr[j].label << std::endl;
+
+				std::cout << "Symmetric area difference :  " << vecerr[j].symdiff << std::endl;
+
+				std::cout << "Intersection over union :  " << vecerr[j].iou << std::endl;
+
+				std::cout << "Hausdorff Distance :  " << vecerr[j].hausdist << std::endl;
+			}
+		}
+		return 0;
+	}
+
+	if(vm.count("stream"))
+	{
+		for(unsigned int i = 0; i < vecimgcmp.size(); i++)
+		{
+			fileio::ShapeReader::Ptr readerref = fileio::OpenShapeReader(imgref);
+			if(!readerref)
+			{
+				std::cerr << "Cannot read " << imgref << std::endl;
+				return 1;
+			}
+			fileio::ShapeReader::Ptr readercmp = fileio::OpenShapeReader(vecimgcmp[i]);
+			if(!readercmp)
+			{
+				std::cerr << "Cannot read " << vecimgcmp[i] << std::endl;
+				return 1;
+			}
+
+			algorithm::evaluation::StreamErrors err = algorithm::evaluation::StreamError(readerref,readercmp,algorithm::evaluation::OptionsStream(bandheight));
+
+			if(vecimgcmp.size() > 1)
+				std::cout << vecimgcmp[i] << std::endl;
+
+			std::cout << "Symmetric area difference :  " << err.symdiff << std::endl;
+
+			std::cout << "Hausdorff Distance :  " << err.hausdist << std::endl;
+		}
+		return 0;
+	}
 
-	std::cout << "Symmetric area difference :  " << symdiff << std::endl;
+	shape::DiscreteShape<2>::Ptr disshref = fileio::ReadShape(imgref);
+	if(!disshref)
+	{
+		std::cerr << "Cannot read " << imgref << std::endl;
+		return 1;
+	}
+
+	if(metrics != 0)
+	{
+		algorithm::evaluation::MetricSet metricset(metrics);
+
+		for(unsigned int i = 0; i < vecimgcmp.size(); i++)
+		{
+			shape::DiscreteShape<2>::Ptr disshcmp = fileio::ReadShape(vecimgcmp[i]);
+			if(!disshcmp)
+			{
+				std::cerr << "Cannot read " << vecimgcmp[i] << std::endl;
+				return 1;
+			}
+
+			algorithm::evaluation::MetricSet::Values val = metricset.evaluate(disshref,disshcmp);
+
+			if(vecimgcmp.size() > 1)
+				std::cout << vecimgcmp[i] << std::endl;
 
-	boundary::DiscreteBoundary<2>::Ptr bndref = algorithm::extractboundary::NaiveBoundary(disshref);
-	boundary::DiscreteBoundary<2>::Ptr bndcmp = algorithm::extractboundary::NaiveBoundary(disshcmp);
+			if(metrics & algorithm::evaluation::MetricSet::iou)
+				std::cout << "Intersection over union :  " << val.iou << std::endl;
 
-	double hausdist = algorithm::evaluation::HausDist(bndref,bndcmp);
+			if(metrics & algorithm::evaluation::MetricSet::dice)
+				std::cout << "Dice coefficient :  " << val.dice << std::endl;
 
-	std::cout << "Hausdorff Distance :  " << hausdist << std::endl;
+			if(metrics & algorithm::evaluation::MetricSet::symdiff)
+				std::cout << "Symmetric area difference :  " << val.symdiff << std::endl;
+
+			if(metrics & algorithm::evaluation::MetricSet::hausdist)
+				std::cout << "Hausdorff Distance (boundary pixels) :  " << val.hausdist << std::endl;
+
+			if(metrics & algorithm::evaluation::MetricSet::avgsurfdist)
+				std::cout << "Average surface distance (boundary pixels) :  " << val.avgsurfdist << std::endl;
+		}
+		return 0;
+	}
+
+	algorithm::evaluation::ReferenceShape reference(disshref);
+
+	// compared images are loaded batch by batch, only one batch is in memory at a time
+	for(unsigned int beg = 0, end = 0; beg < vecimgcmp.size(); beg = end)
+	{
+		end = beg + std::min(batchsize, (unsigned int)vecimgcmp.size() - beg);
+
+		std::vector<shape::DiscreteShape<2>::Ptr> vecdissh(end - beg);
+		for(unsigned int i = beg; i < end; i++)
+		{
+			vecdissh[i - beg] = fileio::ReadShape(vecimgcmp[i]);
+			if(!vecdissh[i - beg])
+			{
+				std::cerr << "Cannot read " << vecimgcmp[i] << std::endl;
+				return 1;
+			}
+		}
+
+		std::vector<algorithm::evaluation::ReferenceShape::Errors> vecerr = reference.evaluate(vecdissh);
+
+		for(unsigned int i = 0; i < vecerr.size(); i++)
+		{
+			if(vecimgcmp.size() > 1)
+				std::cout << vecimgcmp[beg + i] << std::endl;
+
+			std::cout << "Symmetric area difference :  " << vecerr[i].symdiff << std::endl;
+
+			std::cout << "Hausdorff Distance :  " << vecerr[i].hausdist << std::endl;
+		}
+	}
 
 	return 0;
 }
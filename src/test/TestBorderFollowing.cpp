@@ -0,0 +1,96 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestBorderFollowing.cpp
+ *  \brief Border following against the naive boundary extraction
+ *  \author Bastien Durix
+ */
+
+#include <cmath>
+#include <algorithm/extractboundary/BorderFollowing.h>
+#include <algorithm/extractboundary/NaiveBoundary.h>
+#include "Tests.h"
+
+/**
+ *  \brief Tests if a shape has a saddle corner, two diagonal pixels in and the two others out
+ *
+ *  \param dissh tested shape
+ *
+ *  \return true if a corner is a saddle
+ */
+static bool HasSaddle(const shape::DiscreteShape<2>::Ptr dissh)
+{
+	const int width = dissh->getWidth(), height = dissh->getHeight();
+	const std::vector<unsigned char> &disc = dissh->getContainer();
+	auto in = [&disc,width,height](int c, int l)
+	{
+		return c >= 0 && l >= 0 && c < width && l < height && disc[c + width * l] != 0;
+	};
+
+	for(int l = 0; l <= height; l++)
+		for(int c = 0; c <= width; c++)
+			if(in(c-1,l-1) == in(c,l) && in(c,l-1) == in(c-1,l) && in(c-1,l-1) != in(c,l-1))
+				return true;
+	return false;
+}
+
+bool TestBorderFollowing()
+{
+	bool ok = true;
+
+	std::mt19937 gen(5);
+	for(unsigned int it = 0; it < 3000 && ok; it++)
+	{
+		unsigned int width = 1 + gen() % 20, height = 1 + gen() % 20;
+		shape::DiscreteShape<2>::Ptr dissh = RandomShape(gen,width,height,gen() % 100);
+		const std::vector<unsigned char> &disc = dissh->getContainer();
+		boundary::DiscreteBoundary<2>::Ptr bnd = algorithm::extractboundary::BorderFollowing(dissh);
+
+		// one vertex per crack between a pixel in and a pixel out
+		unsigned int nbcracks = 0;
+		for(unsigned int l = 0; l < height; l++)
+			for(unsigned int c = 0; c < width; c++)
+				if(disc[c + width * l])
+				{
+					nbcracks += c == 0 || !disc[c-1 + width * l];
+					nbcracks += c == width-1 || !disc[c+1 + width * l];
+					nbcracks += l == 0 || !disc[c + width * (l-1)];
+					nbcracks += l == height-1 || !disc[c + width * (l+1)];
+				}
+		ok = Check(bnd->getNbVertices() == nbcracks, "border following misses cracks") && ok;
+		for(unsigned int i = 0; i < bnd->getNbVertices() && ok; i++)
+			ok = Check(std::abs((bnd->getCoordinates(i) - bnd->getCoordinates(bnd->getNext(i))).norm() - 1.0) <= 1e-9, "border following links non adjacent corners") && ok;
+
+		// both extractions link saddles differently, elsewhere the loops are identical
+		if(!HasSaddle(dissh))
+		{
+			boundary::DiscreteBoundary<2>::Ptr naive = algorithm::extractboundary::NaiveBoundary(dissh);
+			ok = Check(naive->getNbVertices() == bnd->getNbVertices(), "border following and naive boundary sizes differ") && ok;
+			for(unsigned int i = 0; i < bnd->getNbVertices() && ok; i++)
+				ok = Check(naive->getCoordinates(i) == bnd->getCoordinates(i) && naive->getNext(i) == bnd->getNext(i), "border following differs from naive boundary") && ok;
+		}
+	}
+
+	return ok;
+}
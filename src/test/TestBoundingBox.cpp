@@ -0,0 +1,90 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestBoundingBox.cpp
+ *  \brief Cached bounding box of discrete shapes
+ *  \author Bastien Durix
+ */
+
+#include "Tests.h"
+
+/**
+ *  \brief Tests if a bounding box is the tight box of a shape
+ *
+ *  \param dissh shape
+ *  \param bbox  tested box
+ *
+ *  \return true if the box is the smallest one containing the non zero pixels
+ */
+static bool TightBox(const shape::DiscreteShape<2> &dissh, const shape::DiscreteShape<2>::BoundingBox &bbox)
+{
+	unsigned int cmin = dissh.getWidth(), lmin = dissh.getHeight(), cmax = 0, lmax = 0;
+	for(unsigned int l = 0; l < dissh.getHeight(); l++)
+		for(unsigned int c = 0; c < dissh.getWidth(); c++)
+			if(dissh.getData()[c + dissh.getStride() * l])
+			{
+				cmin = std::min(cmin,c);
+				lmin = std::min(lmin,l);
+				cmax = std::max(cmax,c+1);
+				lmax = std::max(lmax,l+1);
+			}
+
+	if(cmin >= cmax)
+		return bbox.isEmpty();
+	return bbox.cmin == cmin && bbox.lmin == lmin && bbox.cmax == cmax && bbox.lmax == lmax;
+}
+
+bool TestBoundingBox()
+{
+	bool ok = true;
+
+	// boxes of different shapes computed concurrently
+	std::mt19937 gen(6);
+	std::vector<shape::DiscreteShape<2>::Ptr> vecdissh(200);
+	for(unsigned int i = 0; i < vecdissh.size(); i++)
+		vecdissh[i] = RandomShape(gen,1 + gen() % 50,1 + gen() % 50,gen() % 3);
+	std::vector<shape::DiscreteShape<2>::BoundingBox> vecbox(vecdissh.size());
+#pragma omp parallel for
+	for(unsigned int i = 0; i < 4 * vecdissh.size(); i++)
+		vecbox[i % vecdissh.size()] = vecdissh[i % vecdissh.size()]->getBoundingBox();
+	for(unsigned int i = 0; i < vecdissh.size(); i++)
+		ok = Check(TightBox(*vecdissh[i],vecbox[i]), "bounding box is not tight") && ok;
+
+	// pixels written through a kept container, after the box has been cached
+	shape::DiscreteShape<2>::Ptr dissh(new shape::DiscreteShape<2>(20,10));
+	std::vector<unsigned char> &disc = dissh->getWritableContainer();
+	disc[5 + 20 * 3] = 255;
+	const shape::DiscreteShape<2> &shp = *dissh;
+	ok = Check(TightBox(shp,shp.getBoundingBox()), "bounding box of a single pixel") && ok;
+	disc[17 + 20 * 8] = 255;
+	dissh->invalidateBoundingBox();
+	ok = Check(TightBox(shp,shp.getBoundingBox()), "bounding box is not updated after invalidation") && ok;
+
+	// copies keep their own cache
+	shape::DiscreteShape<2> copy(shp);
+	copy.getWritableContainer()[0] = 255;
+	ok = Check(TightBox(copy,copy.getBoundingBox()) && TightBox(shp,shp.getBoundingBox()), "bounding box of a copy") && ok;
+
+	return ok;
+}
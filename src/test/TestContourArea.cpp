@@ -0,0 +1,142 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestContourArea.cpp
+ *  \brief Areas and intersection over union from the boundaries against pixel counts
+ *  \author Bastien Durix
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <algorithm/extractboundary/BorderFollowing.h>
+#include <algorithm/evaluation/ContourArea.h>
+#include "Tests.h"
+
+/**
+ *  \brief Counts the pixels of a connected region
+ *
+ *  \param disc   pixels of the shape, row wise
+ *  \param width  shape width
+ *  \param height shape height
+ *  \param c      column of a pixel of the region
+ *  \param l      row of a pixel of the region
+ *
+ *  \return number of pixels of the region, 4-connected in the shape and 8-connected out of it
+ */
+static unsigned int RegionSize(const std::vector<unsigned char> &disc, int width, int height, int c, int l)
+{
+	bool in = disc[c + width * l] != 0;
+	std::vector<bool> visited(disc.size(),false);
+	std::vector<int> stack(1,c + width * l);
+	visited[c + width * l] = true;
+	unsigned int size = 0;
+	while(stack.size() != 0)
+	{
+		int ind = stack.back();
+		stack.pop_back();
+		size++;
+		for(int dl = -1; dl <= 1; dl++)
+			for(int dc = -1; dc <= 1; dc++)
+			{
+				int cn = ind % width + dc, ln = ind / width + dl;
+				if((in && dc != 0 && dl != 0) || cn < 0 || ln < 0 || cn >= width || ln >= height)
+					continue;
+				int indn = cn + width * ln;
+				if(!visited[indn] && (disc[indn] != 0) == in)
+				{
+					visited[indn] = true;
+					stack.push_back(indn);
+				}
+			}
+	}
+	return size;
+}
+
+bool TestContourArea()
+{
+	using namespace algorithm::evaluation;
+	bool ok = true;
+
+	// concentric square rings, two components and two holes around a center component
+	shape::DiscreteShape<2>::Ptr rings(new shape::DiscreteShape<2>(21,21));
+	for(int l = 0; l < 21; l++)
+		for(int c = 0; c < 21; c++)
+			rings->getWritableContainer()[c + 21 * l] = (std::max(std::abs(c - 10),std::abs(l - 10)) / 2) % 2 == 0 ? 255 : 0;
+
+	// disks overlapping an odd number of times: holes, and components nested in the holes
+	std::mt19937 gen(14);
+	for(unsigned int it = 0; it < 300 && ok; it++)
+	{
+		unsigned int width = 1 + gen() % 60, height = 1 + gen() % 60;
+		if(it == 0)
+			width = height = 21;
+		shape::DiscreteShape<2>::Ptr dissh1 = it == 0 ? rings : it % 3 == 0 ? RandomShape(gen,width,height,gen() % 100) : RandomDisks(gen,width,height,gen() % 8);
+		shape::DiscreteShape<2>::Ptr dissh2 = it % 3 == 0 ? RandomShape(gen,width,height,gen() % 100) : RandomDisks(gen,width,height,gen() % 8);
+		const std::vector<unsigned char> &disc1 = dissh1->getContainer(), &disc2 = dissh2->getContainer();
+
+		std::vector<int> parent(0);
+		boundary::DiscreteBoundary<2>::Ptr bnd1 = algorithm::extractboundary::BorderFollowing(dissh1,parent);
+		boundary::DiscreteBoundary<2>::Ptr bnd2 = algorithm::extractboundary::BorderFollowing(dissh2);
+		if(it == 0)
+		{
+			unsigned int depthmax = 0;
+			for(unsigned int k = 0; k < parent.size(); k++)
+			{
+				unsigned int depth = 0;
+				for(int j = k; j != -1; j = parent[j])
+					depth++;
+				depthmax = std::max(depthmax,depth);
+			}
+			ok = Check(bnd1->getNbLoops() == 5 && depthmax == 5, "loops of the nested rings") && ok;
+		}
+
+		unsigned int area1 = 0, area2 = 0, areainter = 0;
+		for(unsigned int i = 0; i < disc1.size(); i++)
+		{
+			area1 += disc1[i] != 0;
+			area2 += disc2[i] != 0;
+			areainter += disc1[i] != 0 && disc2[i] != 0;
+		}
+		ok = Check(ContourArea(bnd1) == (double)area1, "contour area differs from the pixel count") && ok;
+
+		// region of each loop: the component or the hole on its side, without the loops nested in it
+		std::vector<double> areas = RegionAreas(bnd1,parent);
+		for(unsigned int k = 0; k < bnd1->getNbLoops() && ok; k++)
+		{
+			unsigned int beg = bnd1->getLoopBegin(k);
+			Eigen::Vector2d pt1 = bnd1->getCoordinates(beg), pt2 = bnd1->getCoordinates(bnd1->getNext(beg));
+			// the shape is on the right of the border
+			Eigen::Vector2d normal(pt1.y() - pt2.y(), pt2.x() - pt1.x());
+			Eigen::Vector2d pix = 0.5 * (pt1 + pt2 + (areas[k] > 0.0 ? normal : -normal));
+			unsigned int size = RegionSize(disc1,width,height,(int)std::floor(pix.x()),(int)std::floor(pix.y()));
+			ok = Check(std::abs(areas[k]) == (double)size && (areas[k] > 0.0) == (ContourArea(bnd1,k) > 0.0), "region area differs from the pixel count") && ok;
+		}
+
+		double iou = area1 + area2 == 0 ? 1.0 : (double)areainter / (double)(area1 + area2 - areainter);
+		ok = Check(std::abs(IoU(bnd1,bnd2) - iou) <= 1e-12, "IoU differs from the pixel counts") && ok;
+	}
+
+	return ok;
+}
@@ -0,0 +1,89 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestDistanceMap.cpp
+ *  \brief Distance transform against brute force
+ *  \author Bastien Durix
+ */
+
+#include <cmath>
+#include <limits>
+#include <algorithm/evaluation/DistanceMap.h>
+#include <algorithm/evaluation/ShapeError.h>
+#include "Tests.h"
+
+bool TestDistanceMap()
+{
+	using namespace algorithm::evaluation;
+	bool ok = true;
+
+	std::mt19937 gen(12);
+	for(unsigned int it = 0; it < 500 && ok; it++)
+	{
+		unsigned int width = 1 + gen() % 30, height = 1 + gen() % 30;
+		shape::DiscreteShape<2>::Ptr shpref = RandomShape(gen,width,height,it % 10 == 0 ? 0 : gen() % 30);
+		shape::DiscreteShape<2>::Ptr shpcmp = RandomShape(gen,width,height,it % 10 == 5 ? 0 : gen() % 30);
+		DistanceMap dismapref(shpref), dismapcmp(shpcmp);
+		const std::vector<std::size_t> &bndref = dismapref.getBoundary(), &bndcmp = dismapcmp.getBoundary();
+
+		// squared distance of each pixel to the nearest boundary pixel
+		for(unsigned int i = 0; i < width * height && ok; i++)
+		{
+			unsigned long long sqdist = std::numeric_limits<unsigned long long>::max();
+			for(unsigned int j = 0; j < bndref.size(); j++)
+			{
+				long long dc = (long long)(i % width) - (long long)(bndref[j] % width);
+				long long dl = (long long)(i / width) - (long long)(bndref[j] / width);
+				sqdist = std::min(sqdist,(unsigned long long)(dc * dc + dl * dl));
+			}
+			ok = Check(dismapref.getSqDist(i) == sqdist, "distance map differs from brute force") && ok;
+		}
+
+		// Hausdorff distance between the boundary pixels
+		double distbf = 0.0;
+		for(unsigned int k = 0; k < 2; k++)
+		{
+			const std::vector<std::size_t> &bnd1 = k == 0 ? bndref : bndcmp, &bnd2 = k == 0 ? bndcmp : bndref;
+			for(unsigned int i = 0; i < bnd1.size(); i++)
+			{
+				double distmin = std::numeric_limits<double>::infinity();
+				for(unsigned int j = 0; j < bnd2.size(); j++)
+					distmin = std::min(distmin,std::hypot((double)(bnd1[i] % width) - (double)(bnd2[j] % width),(double)(bnd1[i] / width) - (double)(bnd2[j] / width)));
+				distbf = std::max(distbf,distmin);
+			}
+		}
+		if(bndref.size() == 0 && bndcmp.size() == 0)
+			distbf = 0.0;
+		ok = Check(HausDist(dismapref,dismapcmp) == distbf, "distance map HausDist differs from brute force") && ok;
+	}
+
+	// squared distances beyond 32 bits
+	const unsigned int height = 70000;
+	shape::DiscreteShape<2>::Ptr dissh(new shape::DiscreteShape<2>(1,height));
+	dissh->getWritableContainer()[0] = 255;
+	DistanceMap dismap(dissh);
+	ok = Check(dismap.getSqDist(height-1) == (unsigned long long)(height-1) * (height-1), "distance map overflows") && ok;
+
+	return ok;
+}
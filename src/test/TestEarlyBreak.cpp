@@ -0,0 +1,52 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestEarlyBreak.cpp
+ *  \brief Early break Hausdorff distance against brute force
+ *  \author Bastien Durix
+ */
+
+#include <algorithm/evaluation/ShapeError.h>
+#include "Tests.h"
+
+bool TestEarlyBreak()
+{
+	using namespace algorithm::evaluation;
+	bool ok = true;
+
+	// the shared maximum is updated concurrently, the result has to stay exact
+	std::mt19937 gen(3);
+	for(unsigned int it = 0; it < 300 && ok; it++)
+	{
+		unsigned int range = 1 + gen() % (it % 2 == 0 ? 10 : 1000);
+		boundary::DiscreteBoundary<2>::Ptr bnd1 = RandomBoundary(gen,1 + gen() % 3,500,range);
+		boundary::DiscreteBoundary<2>::Ptr bnd2 = RandomBoundary(gen,1 + gen() % 3,500,range * (1 + it % 3));
+
+		double distbf = HausDistBruteForce(bnd1,bnd2);
+		ok = Check(HausDistEarlyBreak(bnd1,bnd2) == distbf, "early break HausDist differs from brute force") && ok;
+		ok = Check(HausDistEarlyBreak(bnd2,bnd1) == distbf, "early break HausDist is not symmetric") && ok;
+	}
+
+	return ok;
+}
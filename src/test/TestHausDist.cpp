@@ -0,0 +1,81 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestHausDist.cpp
+ *  \brief Indexed Hausdorff distance against brute force
+ *  \author Bastien Durix
+ */
+
+#include <cmath>
+#include <limits>
+#include <algorithm/evaluation/ShapeError.h>
+#include <algorithm/evaluation/BoundaryGrid.h>
+#include "Tests.h"
+
+bool TestHausDist()
+{
+	using namespace algorithm::evaluation;
+	bool ok = true;
+
+	// random boundaries, integer coordinates on small ranges give many ties
+	std::mt19937 gen(1);
+	for(unsigned int it = 0; it < 300 && ok; it++)
+	{
+		unsigned int range = 1 + gen() % (it % 2 == 0 ? 10 : 500);
+		boundary::DiscreteBoundary<2>::Ptr bnd1 = RandomBoundary(gen,1 + gen() % 3,200,range);
+		boundary::DiscreteBoundary<2>::Ptr bnd2 = RandomBoundary(gen,1 + gen() % 3,200,range * (1 + it % 4));
+
+		double distbf = HausDistBruteForce(bnd1,bnd2);
+		HausDistDetails details;
+		ok = Check(HausDist(bnd1,bnd2,OptionsHausDist(HausDistMethod::indexed)) == distbf, "indexed HausDist differs from brute force") && ok;
+		ok = Check(HausDist(bnd1,bnd2) == distbf, "automatic HausDist differs from brute force") && ok;
+		ok = Check(HausDist(BoundaryGrid(bnd1),BoundaryGrid(bnd2)) == distbf, "grid HausDist differs from brute force") && ok;
+		ok = Check(HausDist(bnd1,bnd2,details,true) == distbf, "HausDist with details differs from brute force") && ok;
+		ok = Check(std::abs((details.point1 - details.point2).norm() - distbf) <= 1e-9, "witness is not at Hausdorff distance") && ok;
+		ok = Check(std::abs(HausDistSegments(bnd1,bnd2) - HausDistSegmentsBruteForce(bnd1,bnd2)) <= 1e-9, "segments HausDist differs from brute force") && ok;
+	}
+
+	// ties: every vertex is at distance 1 of the other boundary, the witness is the lowest pair of indices
+	boundary::DiscreteBoundary<2>::Ptr square(new boundary::DiscreteBoundary<2>());
+	boundary::DiscreteBoundary<2>::Ptr segment(new boundary::DiscreteBoundary<2>());
+	square->addVerticesVector(std::vector<Eigen::Vector2d>{Eigen::Vector2d(0.0,0.0),Eigen::Vector2d(2.0,0.0),Eigen::Vector2d(2.0,2.0),Eigen::Vector2d(0.0,2.0)});
+	segment->addVerticesVector(std::vector<Eigen::Vector2d>{Eigen::Vector2d(0.0,1.0),Eigen::Vector2d(2.0,1.0)});
+	HausDistDetails details;
+	ok = Check(HausDistBruteForce(square,segment) == 1.0, "brute force HausDist on ties") && ok;
+	ok = Check(HausDist(square,segment,OptionsHausDist(HausDistMethod::indexed)) == 1.0, "indexed HausDist on ties") && ok;
+	ok = Check(HausDist(square,segment,details) == 1.0 && details.index1 == 0 && details.index2 == 0, "witness on ties") && ok;
+
+	// empty boundaries
+	const double inf = std::numeric_limits<double>::infinity();
+	boundary::DiscreteBoundary<2>::Ptr empty(new boundary::DiscreteBoundary<2>());
+	for(HausDistMethod method : {HausDistMethod::bruteforce,HausDistMethod::indexed,HausDistMethod::earlybreak})
+	{
+		ok = Check(HausDist(empty,empty,OptionsHausDist(method)) == 0.0, "HausDist between empty boundaries") && ok;
+		ok = Check(HausDist(square,empty,OptionsHausDist(method)) == inf, "HausDist to an empty boundary") && ok;
+		ok = Check(HausDist(empty,square,OptionsHausDist(method)) == inf, "HausDist from an empty boundary") && ok;
+	}
+	ok = Check(HausDist(square,empty,details) == inf && details.hausdist == inf, "HausDist with details to an empty boundary") && ok;
+
+	return ok;
+}
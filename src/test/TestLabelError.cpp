@@ -0,0 +1,129 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestLabelError.cpp
+ *  \brief Multi-label evaluation against the evaluation of each binarized label
+ *  \author Bastien Durix
+ */
+
+#include <limits>
+#include <shape/LabelShape.h>
+#include <algorithm/evaluation/LabelError.h>
+#include <algorithm/evaluation/ShapeError.h>
+#include <algorithm/evaluation/BoundaryGrid.h>
+#include <algorithm/extractboundary/BorderFollowing.h>
+#include "Tests.h"
+
+/**
+ *  \brief Random label shape, made of disks of random labels
+ *
+ *  \param gen     random generator
+ *  \param width   width of the shape
+ *  \param height  height of the shape
+ *  \param nbdisks number of disks
+ *
+ *  \return label shape, with labels from 0 to 4
+ */
+static shape::LabelShape<2>::Ptr RandomLabels(std::mt19937 &gen, unsigned int width, unsigned int height, unsigned int nbdisks)
+{
+	shape::LabelShape<2>::Ptr labsh(new shape::LabelShape<2>(width,height));
+	std::vector<unsigned char> &labels = labsh->getContainer();
+	for(unsigned int k = 0; k < nbdisks; k++)
+	{
+		double cx = gen() % width, cy = gen() % height, rad = 1 + gen() % (width / 3 + 1);
+		unsigned char label = gen() % 5;
+		for(unsigned int l = 0; l < height; l++)
+			for(unsigned int c = 0; c < width; c++)
+				if((c - cx) * (c - cx) + (l - cy) * (l - cy) < rad * rad)
+					labels[c + width * l] = gen() % 30 == 0 ? gen() % 5 : label;
+	}
+	return labsh;
+}
+
+bool TestLabelError()
+{
+	using namespace algorithm::evaluation;
+	const double inf = std::numeric_limits<double>::infinity();
+	bool ok = true;
+
+	// more lines than a chunk, and a background which is not 0 every third map
+	std::mt19937 gen(5);
+	for(unsigned int it = 0; it < 300 && ok; it++)
+	{
+		unsigned int width = 1 + gen() % 80, height = 1 + gen() % 150;
+		shape::LabelShape<2>::Ptr labref = RandomLabels(gen,width,height,gen() % 6);
+		shape::LabelShape<2>::Ptr labcmp = RandomLabels(gen,width,height,gen() % 6);
+		unsigned char background = it % 3 == 0 ? 2 : 0;
+		std::vector<LabelErrors> vecerr = LabelError(labref,labcmp,OptionsLabelError(background));
+
+		unsigned int ind = 0;
+		for(unsigned int label = 0; label < 256; label++)
+		{
+			if(label == background)
+				continue;
+
+			shape::DiscreteShape<2>::Ptr mskref = labref->getMask(label), mskcmp = labcmp->getMask(label);
+			unsigned long long arearef = 0, areacmp = 0, areainter = 0;
+			for(unsigned int i = 0; i < width * height; i++)
+			{
+				arearef += mskref->getContainer()[i] != 0;
+				areacmp += mskcmp->getContainer()[i] != 0;
+				areainter += mskref->getContainer()[i] != 0 && mskcmp->getContainer()[i] != 0;
+			}
+			if(arearef == 0 && areacmp == 0)
+				continue;
+
+			if(!Check(ind < vecerr.size() && vecerr[ind].label == label, "label missing from the errors"))
+			{
+				ok = false;
+				break;
+			}
+			const LabelErrors &err = vecerr[ind++];
+			double symdiff = arearef == 0 ? inf : (double)(arearef + areacmp - 2 * areainter)/(double)arearef;
+			double hausdist = HausDist(BoundaryGrid(algorithm::extractboundary::BorderFollowing(mskref)),BoundaryGrid(algorithm::extractboundary::BorderFollowing(mskcmp)));
+			ok = Check(err.arearef == arearef && err.areacmp == areacmp && err.areainter == areainter, "label areas differ") && ok;
+			ok = Check(err.symdiff == symdiff, "label symmetric difference differs") && ok;
+			ok = Check(err.iou == (double)areainter/(double)(arearef + areacmp - areainter), "label intersection over union differs") && ok;
+			ok = Check(err.hausdist == hausdist, "label Hausdorff distance differs") && ok;
+		}
+		ok = Check(ind == vecerr.size(), "errors of absent labels") && ok;
+	}
+
+	// label 1 only in the reference, label 2 only in the compared shape
+	shape::LabelShape<2>::Ptr labref(new shape::LabelShape<2>(10,10)), labcmp(new shape::LabelShape<2>(10,10));
+	for(unsigned int i = 0; i < 30; i++)
+	{
+		labref->getContainer()[i] = 1;
+		labcmp->getContainer()[i+50] = 2;
+	}
+	std::vector<LabelErrors> vecerr = LabelError(labref,labcmp);
+	ok = Check(vecerr.size() == 2, "labels missing on one side are not reported") && ok;
+	if(vecerr.size() == 2)
+	{
+		ok = Check(vecerr[0].label == 1 && vecerr[0].symdiff == 1.0 && vecerr[0].iou == 0.0 && vecerr[0].hausdist == inf, "label missing in the compared shape") && ok;
+		ok = Check(vecerr[1].label == 2 && vecerr[1].symdiff == inf && vecerr[1].iou == 0.0 && vecerr[1].hausdist == inf, "label missing in the reference") && ok;
+	}
+
+	return ok;
+}
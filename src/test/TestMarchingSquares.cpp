@@ -0,0 +1,82 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestMarchingSquares.cpp
+ *  \brief Marching squares against border following on a fixture
+ *  \author Bastien Durix
+ */
+
+#include <cmath>
+#include <algorithm/extractboundary/BorderFollowing.h>
+#include <algorithm/extractboundary/MarchingSquares.h>
+#include <algorithm/evaluation/ContourArea.h>
+#include "Tests.h"
+
+bool TestMarchingSquares()
+{
+	using namespace algorithm::extractboundary;
+	using algorithm::evaluation::ContourArea;
+	bool ok = true;
+
+	// square with a square hole, and a square island in the hole
+	shape::DiscreteShape<2>::Ptr dissh(new shape::DiscreteShape<2>(12,12));
+	std::vector<unsigned char> &disc = dissh->getWritableContainer();
+	for(unsigned int l = 0; l < 12; l++)
+		for(unsigned int c = 0; c < 12; c++)
+		{
+			bool square = c >= 1 && c <= 10 && l >= 1 && l <= 10;
+			bool hole = c >= 3 && c <= 8 && l >= 3 && l <= 8;
+			bool island = c >= 5 && c <= 6 && l >= 5 && l <= 6;
+			disc[c + 12 * l] = (square && !hole) || island ? 255 : 0;
+		}
+
+	boundary::DiscreteBoundary<2>::Ptr crack = BorderFollowing(dissh);
+	boundary::DiscreteBoundary<2>::Ptr bnd = MarchingSquares(dissh);
+	boundary::DiscreteBoundary<2>::Ptr simpl = MarchingSquares(dissh,OptionsMarchingSquares(127.5,true));
+
+	ok = Check(crack->getNbLoops() == 3 && bnd->getNbLoops() == 3 && simpl->getNbLoops() == 3, "marching squares loops differ from border following") && ok;
+	ok = Check(bnd->getNbVertices() == crack->getNbVertices(), "marching squares vertices are not one per pixel border") && ok;
+	ok = Check(ContourArea(crack) == 68.0, "pixel area of the fixture") && ok;
+
+	// midpoints of the pixel borders cut a triangle of area 1/8 at each corner of the loops
+	for(unsigned int k = 0; k < crack->getNbLoops() && ok; k++)
+	{
+		double areacrack = ContourArea(crack,k);
+		double expected = areacrack - std::copysign(0.5,areacrack);
+		ok = Check(std::abs(ContourArea(bnd,k) - expected) <= 1e-9, "marching squares loop area") && ok;
+		ok = Check(std::abs(ContourArea(simpl,k) - expected) <= 1e-9, "simplified marching squares loop area") && ok;
+		ok = Check(simpl->getLoopEnd(k) - simpl->getLoopBegin(k) == 8, "simplified marching squares keeps aligned vertices") && ok;
+	}
+
+	// interpolation on a field: the iso-level moves the borders
+	std::vector<float> field(12 * 12);
+	for(unsigned int i = 0; i < field.size(); i++)
+		field[i] = disc[i] ? 1.0f : 0.0f;
+	boundary::DiscreteBoundary<2>::Ptr bndlow = MarchingSquares(field,12,12,OptionsMarchingSquares(0.25));
+	boundary::DiscreteBoundary<2>::Ptr bndhigh = MarchingSquares(field,12,12,OptionsMarchingSquares(0.75));
+	ok = Check(bndlow->getNbLoops() == 3 && bndhigh->getNbLoops() == 3, "marching squares loops on a field") && ok;
+	ok = Check(ContourArea(bndlow) > ContourArea(bnd) && ContourArea(bndhigh) < ContourArea(bnd), "iso-level does not move the borders") && ok;
+
+	return ok;
+}
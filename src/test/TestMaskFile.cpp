@@ -0,0 +1,114 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestMaskFile.cpp
+ *  \brief Mask files read through the generic shape readers
+ *  \author Bastien Durix
+ */
+
+#include "Tests.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <fileio/MaskFile.h>
+#include <fileio/ShapeFile.h>
+
+/**
+ *  \brief Tests if two shapes have the same pixels
+ *
+ *  \param dissh1 first shape
+ *  \param dissh2 second shape
+ *
+ *  \return true if the shapes have the same size and the same non zero pixels
+ */
+static bool SamePixels(const shape::DiscreteShape<2> &dissh1, const shape::DiscreteShape<2> &dissh2)
+{
+	if(dissh1.getWidth() != dissh2.getWidth() || dissh1.getHeight() != dissh2.getHeight())
+		return false;
+	for(unsigned int l = 0; l < dissh1.getHeight(); l++)
+		for(unsigned int c = 0; c < dissh1.getWidth(); c++)
+			if((dissh1.getData()[c + dissh1.getStride() * l] != 0) != (dissh2.getData()[c + dissh2.getStride() * l] != 0))
+				return false;
+	return true;
+}
+
+bool TestMaskFile()
+{
+	bool ok = true;
+	const std::string filename = "test_maskfile.evsk";
+
+	std::mt19937 gen(7);
+	for(unsigned int i = 0; i < 10; i++)
+	{
+		shape::DiscreteShape<2>::Ptr dissh = RandomShape(gen,1 + gen() % 130,1 + gen() % 40,50);
+		for(fileio::MaskEncoding encoding : {fileio::MaskEncoding::bytes, fileio::MaskEncoding::packed})
+		{
+			fileio::WriteMaskFile(dissh,filename,encoding);
+
+			shape::DiscreteShape<2>::Ptr readsh = fileio::ReadShape(filename);
+			ok = Check(readsh && SamePixels(*dissh,*readsh), "ReadShape on a mask file") && ok;
+
+			shape::PackedShape<2>::Ptr packsh = fileio::ReadPackedShape(filename);
+			ok = Check(packsh && SamePixels(*dissh,*packsh->unpack()), "ReadPackedShape on a mask file") && ok;
+
+			fileio::ShapeReader::Ptr reader = fileio::OpenShapeReader(filename);
+			if(Check((bool)reader, "OpenShapeReader on a mask file"))
+			{
+				shape::DiscreteShape<2> rows(reader->getWidth(),reader->getHeight());
+				for(unsigned int l = 0; l < reader->getHeight(); l++)
+					reader->readRow(rows.getWritableData() + rows.getStride() * l);
+				ok = Check(SamePixels(*dissh,rows), "rows read from a mask file") && ok;
+			}
+			else
+				ok = false;
+
+			readsh.reset();
+			packsh.reset();
+			reader.reset();
+			std::remove(filename.c_str());
+		}
+	}
+
+	// a set padding bit, past the width of a row, is rejected
+	fileio::WriteMaskFile(RandomShape(gen,70,3,50),filename,fileio::MaskEncoding::packed);
+	std::ifstream file(filename,std::ios::binary);
+	std::string content((std::istreambuf_iterator<char>(file)),std::istreambuf_iterator<char>());
+	file.close();
+	content[content.size()-1] |= (char)0x80;
+	WriteFile(filename,content);
+	bool thrown = false;
+	try
+	{
+		fileio::MapPackedMaskFile(filename);
+	}
+	catch(const std::logic_error &)
+	{
+		thrown = true;
+	}
+	std::remove(filename.c_str());
+	ok = Check(thrown, "packed mask file with padding bits") && ok;
+
+	return ok;
+}
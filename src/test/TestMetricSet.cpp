@@ -0,0 +1,80 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestMetricSet.cpp
+ *  \brief Metric set against the standalone errors and pixel counts
+ *  \author Bastien Durix
+ */
+
+#include <cmath>
+#include <algorithm/evaluation/ShapeError.h>
+#include <algorithm/evaluation/DistanceMap.h>
+#include <algorithm/evaluation/MetricSet.h>
+#include "Tests.h"
+
+bool TestMetricSet()
+{
+	using namespace algorithm::evaluation;
+	bool ok = true;
+
+	// smooth shapes with holes and nested components
+	std::mt19937 gen(18);
+	for(unsigned int it = 0; it < 50 && ok; it++)
+	{
+		unsigned int width = 10 + gen() % 100, height = 10 + gen() % 60;
+		shape::DiscreteShape<2>::Ptr shpref = RandomDisks(gen,width,height,1 + gen() % 6);
+		shape::DiscreteShape<2>::Ptr shpcmp = RandomDisks(gen,width,height,1 + gen() % 6);
+
+		unsigned long long arearef = 0, areacmp = 0, areainter = 0;
+		for(unsigned int l = 0; l < height; l++)
+			for(unsigned int c = 0; c < width; c++)
+			{
+				bool inref = shpref->getData()[c + shpref->getStride() * l] != 0;
+				bool incmp = shpcmp->getData()[c + shpcmp->getStride() * l] != 0;
+				arearef += inref;
+				areacmp += incmp;
+				areainter += (inref && incmp);
+			}
+
+		MetricSet::Values val = MetricSet().evaluate(shpref,shpcmp);
+		ok = Check(val.iou == (double)areainter / (double)(arearef + areacmp - areainter), "MetricSet iou differs from pixel counts") && ok;
+		ok = Check(val.dice == 2.0 * (double)areainter / (double)(arearef + areacmp), "MetricSet dice differs from pixel counts") && ok;
+		ok = Check(val.symdiff == SymDiffArea(shpref,shpcmp), "MetricSet symdiff differs from SymDiffArea") && ok;
+
+		DistanceMap dismapref(shpref), dismapcmp(shpcmp);
+		double avgsurfdist = AvgSurfDist(dismapref,dismapcmp);
+		ok = Check(val.hausdist == HausDist(dismapref,dismapcmp), "MetricSet hausdist differs from the distance map HausDist") && ok;
+		ok = Check(std::abs(val.avgsurfdist - avgsurfdist) <= 1e-9 * (1.0 + avgsurfdist), "MetricSet avgsurfdist differs from AvgSurfDist") && ok;
+
+		// metrics that are not requested are not computed
+		MetricSet::Values valarea = MetricSet(MetricSet::area).evaluate(shpref,shpcmp);
+		ok = Check(valarea.iou == val.iou && valarea.dice == val.dice && valarea.symdiff == val.symdiff, "MetricSet area metrics depend on the distances") && ok;
+		ok = Check(std::isnan(valarea.hausdist) && std::isnan(valarea.avgsurfdist), "MetricSet distances computed without being requested") && ok;
+		MetricSet::Values valdist = MetricSet(MetricSet::hausdist).evaluate(shpref,shpcmp);
+		ok = Check(valdist.hausdist == val.hausdist, "MetricSet hausdist depends on the other metrics") && ok;
+		ok = Check(std::isnan(valdist.iou) && std::isnan(valdist.dice) && std::isnan(valdist.symdiff) && std::isnan(valdist.avgsurfdist), "MetricSet metrics computed without being requested") && ok;
+	}
+
+	return ok;
+}
@@ -0,0 +1,67 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestMultiRes.cpp
+ *  \brief Coarse to fine Hausdorff distance against the distance transform one
+ *  \author Bastien Durix
+ */
+
+#include <limits>
+#include <algorithm/evaluation/ShapeError.h>
+#include "Tests.h"
+
+bool TestMultiRes()
+{
+	using namespace algorithm::evaluation;
+	bool ok = true;
+
+	// odd sizes, several pyramid depths, empty shapes on one side or both
+	std::mt19937 gen(13);
+	for(unsigned int it = 0; it < 500 && ok; it++)
+	{
+		unsigned int width = 1 + gen() % 80, height = 1 + gen() % 80;
+		shape::DiscreteShape<2>::Ptr shpref = it % 2 == 0 ? RandomDisks(gen,width,height,1 + gen() % 5) : RandomShape(gen,width,height,gen() % 20);
+		shape::DiscreteShape<2>::Ptr shpcmp = it % 2 == 0 ? RandomDisks(gen,width,height,1 + gen() % 5) : RandomShape(gen,width,height,gen() % 20);
+		if(it % 10 == 1)
+			shpref = RandomShape(gen,width,height,0);
+		if(it % 10 == 3)
+			shpcmp = RandomShape(gen,width,height,0);
+		if(it % 20 == 5)
+			shpref = shpcmp = RandomShape(gen,width,height,0);
+		unsigned int coarsest = 1 + gen() % 16;
+
+		double dist = HausDist(DistanceMap(shpref),DistanceMap(shpcmp));
+		double upper;
+		double lower = HausDistMultiRes(shpref,shpcmp,upper,OptionsMultiRes(0.0,coarsest));
+		ok = Check(lower == dist && upper == dist, "exact multiresolution HausDist differs from the distance transform one") && ok;
+
+		// certified bounds within epsilon
+		double epsilon = 0.5 * (double)(1 + gen() % 8);
+		lower = HausDistMultiRes(shpref,shpcmp,upper,OptionsMultiRes(epsilon,coarsest));
+		ok = Check(lower <= dist && dist <= upper, "multiresolution bounds do not hold the distance") && ok;
+		ok = Check(dist == std::numeric_limits<double>::infinity() || upper - lower <= epsilon, "multiresolution bounds farther than epsilon") && ok;
+	}
+
+	return ok;
+}
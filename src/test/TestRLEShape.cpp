@@ -0,0 +1,96 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestRLEShape.cpp
+ *  \brief Run length encoded shape operations against the dense ones
+ *  \author Bastien Durix
+ */
+
+#include <cmath>
+#include <shape/RLEShape.h>
+#include <shape/PackedShape.h>
+#include <algorithm/extractboundary/BorderFollowing.h>
+#include <algorithm/evaluation/ShapeError.h>
+#include <algorithm/skinning/Filling.h>
+#include <mathtools/geometry/euclidian/HyperSphere.h>
+#include "Tests.h"
+
+/**
+ *  \brief Tests if two boundaries have the same loops
+ *
+ *  \param bnd1 first boundary
+ *  \param bnd2 second boundary
+ *
+ *  \return true if the vertices and their order are identical
+ */
+static bool SameBoundary(const boundary::DiscreteBoundary<2>::Ptr bnd1, const boundary::DiscreteBoundary<2>::Ptr bnd2)
+{
+	bool same = bnd1->getNbVertices() == bnd2->getNbVertices() && bnd1->getNbLoops() == bnd2->getNbLoops();
+	for(unsigned int i = 0; i < bnd1->getNbVertices() && same; i++)
+		same = bnd1->getCoordinates(i) == bnd2->getCoordinates(i) && bnd1->getNext(i) == bnd2->getNext(i);
+	return same;
+}
+
+bool TestRLEShape()
+{
+	using Sphere = mathtools::geometry::euclidian::HyperSphere<2>;
+	bool ok = true;
+
+	std::mt19937 gen(3);
+	for(unsigned int it = 0; it < 2000 && ok; it++)
+	{
+		unsigned int width = 1 + gen() % 30, height = 1 + gen() % 30, density = gen() % 100;
+		shape::DiscreteShape<2>::Ptr disref = RandomShape(gen,width,height,density);
+		shape::DiscreteShape<2>::Ptr discmp = RandomShape(gen,width,height,density);
+		shape::RLEShape<2>::Ptr rleref(new shape::RLEShape<2>(disref));
+		shape::RLEShape<2>::Ptr rlecmp(new shape::RLEShape<2>(discmp));
+
+		std::vector<int> parentdis, parentrle;
+		ok = Check(SameBoundary(algorithm::extractboundary::BorderFollowing(disref,parentdis),algorithm::extractboundary::BorderFollowing(rleref,parentrle)) && parentdis == parentrle, "border following on runs differs") && ok;
+
+		double symdiff = algorithm::evaluation::SymDiffArea(shape::PackedShape<2>::Ptr(new shape::PackedShape<2>(disref)),shape::PackedShape<2>::Ptr(new shape::PackedShape<2>(discmp)));
+		double symdiffrle = algorithm::evaluation::SymDiffArea(rleref,rlecmp);
+		ok = Check(symdiff == symdiffrle || (std::isnan(symdiff) && std::isnan(symdiffrle)), "symmetric difference on runs differs") && ok;
+
+		ok = Check(rleref->unpack()->getContainer() == disref->getContainer(), "runs are not unpacked to the dense shape") && ok;
+	}
+
+	// disks filled in both representations cover the same pixels, including disks crossing the borders
+	std::uniform_real_distribution<double> coord(-20.0,120.0), radius(0.0,30.0);
+	for(unsigned int it = 0; it < 200 && ok; it++)
+	{
+		skeleton::GraphSkel2d::Ptr grskl(new skeleton::GraphSkel2d(skeleton::model::Classic<2>()));
+		unsigned int nbnod = gen() % 20;
+		for(unsigned int i = 0; i < nbnod; i++)
+			grskl->addNode<Sphere>(Sphere(mathtools::affine::Point<2>(coord(gen),coord(gen)),radius(gen)));
+
+		shape::DiscreteShape<2>::Ptr dissh(new shape::DiscreteShape<2>(100,80));
+		shape::RLEShape<2>::Ptr rlesh(new shape::RLEShape<2>(100,80));
+		algorithm::skinning::Filling(dissh,grskl);
+		algorithm::skinning::Filling(rlesh,grskl);
+		ok = Check(rlesh->unpack()->getContainer() == dissh->getContainer(), "disks filled on runs differ") && ok;
+	}
+
+	return ok;
+}
@@ -0,0 +1,155 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestReadImage.cpp
+ *  \brief Evaluation of images in formats decoded by OpenCV
+ *  \author Bastien Durix
+ */
+
+#include "Tests.h"
+#include <cstdio>
+#include <fileio/ShapeFile.h>
+#include <algorithm/evaluation/ReferenceShape.h>
+
+/**
+ *  \brief Appends a little endian integer to a string
+ *
+ *  \param content string to complete
+ *  \param value   appended value
+ *  \param nbbytes number of bytes of the value
+ */
+static void AppendLE(std::string &content, unsigned int value, unsigned int nbbytes)
+{
+	for(unsigned int b = 0; b < nbbytes; b++)
+		content.push_back((char)((value >> (8*b)) & 0xff));
+}
+
+/**
+ *  \brief Writes a shape as a 24 bits BMP image
+ *
+ *  \param filename file name
+ *  \param dissh    written shape
+ *  \param inval    gray level of the pixels in the shape
+ *  \param outval   gray level of the pixels out of the shape
+ */
+static void WriteBMP(const std::string &filename, const shape::DiscreteShape<2> &dissh, unsigned char inval, unsigned char outval)
+{
+	unsigned int rowsize = (3*dissh.getWidth() + 3) / 4 * 4;
+	unsigned int datasize = rowsize * dissh.getHeight();
+
+	std::string content("BM");
+	AppendLE(content,54 + datasize,4);
+	AppendLE(content,0,4);
+	AppendLE(content,54,4);
+	AppendLE(content,40,4);
+	AppendLE(content,dissh.getWidth(),4);
+	AppendLE(content,dissh.getHeight(),4);
+	AppendLE(content,1,2);
+	AppendLE(content,24,2);
+	AppendLE(content,0,4);
+	AppendLE(content,datasize,4);
+	AppendLE(content,2835,4);
+	AppendLE(content,2835,4);
+	AppendLE(content,0,4);
+	AppendLE(content,0,4);
+
+	// rows are stored bottom up
+	for(unsigned int l = dissh.getHeight(); l-- > 0;)
+	{
+		std::string row(rowsize,0);
+		for(unsigned int c = 0; c < dissh.getWidth(); c++)
+			row.replace(3*c,3,3,(char)(dissh.getData()[c + dissh.getStride() * l] ? inval : outval));
+		content += row;
+	}
+
+	WriteFile(filename,content);
+}
+
+/**
+ *  \brief Writes a shape as a raw PGM image
+ *
+ *  \param filename file name
+ *  \param dissh    written shape
+ */
+static void WritePGM(const std::string &filename, const shape::DiscreteShape<2> &dissh)
+{
+	std::string content = "P5\n" + std::to_string(dissh.getWidth()) + " " + std::to_string(dissh.getHeight()) + "\n255\n";
+	for(unsigned int l = 0; l < dissh.getHeight(); l++)
+		content.append((const char*)dissh.getData() + dissh.getStride() * l,dissh.getWidth());
+	WriteFile(filename,content);
+}
+
+/**
+ *  \brief Tests if two shapes have the same pixels
+ *
+ *  \param shp1 first shape
+ *  \param shp2 second shape
+ *
+ *  \return true if both shapes have the same size and pixels
+ */
+static bool SamePixels(const shape::DiscreteShape<2> &shp1, const shape::DiscreteShape<2> &shp2)
+{
+	if(shp1.getWidth() != shp2.getWidth() || shp1.getHeight() != shp2.getHeight())
+		return false;
+	for(unsigned int l = 0; l < shp1.getHeight(); l++)
+		for(unsigned int c = 0; c < shp1.getWidth(); c++)
+			if((shp1.getData()[c + shp1.getStride() * l] != 0) != (shp2.getData()[c + shp2.getStride() * l] != 0))
+				return false;
+	return true;
+}
+
+bool TestReadImage()
+{
+	bool ok = true;
+	std::mt19937 gen(15);
+	const std::string bmpname = "test_readimage.bmp", pgmname = "test_readimage.pgm";
+
+	for(unsigned int i = 0; i < 10; i++)
+	{
+		unsigned int width = 10 + gen() % 40, height = 10 + gen() % 40;
+		shape::DiscreteShape<2>::Ptr shpref = RandomDisks(gen,width,height,1 + gen() % 6);
+		shape::DiscreteShape<2>::Ptr shpcmp = RandomDisks(gen,width,height,1 + gen() % 6);
+
+		// background at the threshold, so that thresholding is checked as well
+		WriteBMP(bmpname,*shpref,200,1);
+		shape::DiscreteShape<2>::Ptr readref = fileio::ReadShape(bmpname);
+		shape::PackedShape<2>::Ptr packref = fileio::ReadPackedShape(bmpname);
+		std::remove(bmpname.c_str());
+		ok = Check(readref && SamePixels(*shpref,*readref), "ReadShape on a BMP image") && ok;
+		ok = Check(packref && packref->getWidth() == width && packref->getHeight() == height, "ReadPackedShape on a BMP image") && ok;
+		if(!readref)
+			continue;
+
+		// BMP reference evaluated against a PGM image, as soft_evalshape does
+		WritePGM(pgmname,*shpcmp);
+		shape::DiscreteShape<2>::Ptr readcmp = fileio::ReadShape(pgmname);
+		std::remove(pgmname.c_str());
+
+		algorithm::evaluation::ReferenceShape::Errors err = algorithm::evaluation::ReferenceShape(readref).evaluate(readcmp);
+		algorithm::evaluation::ReferenceShape::Errors exp = algorithm::evaluation::ReferenceShape(shpref).evaluate(shpcmp);
+		ok = Check(err.symdiff == exp.symdiff && err.hausdist == exp.hausdist, "evaluation of a BMP image") && ok;
+	}
+
+	return ok;
+}
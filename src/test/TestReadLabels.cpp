@@ -0,0 +1,141 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestReadLabels.cpp
+ *  \brief Raw label values read from image files
+ *  \author Bastien Durix
+ */
+
+#include "Tests.h"
+#include <cstdio>
+#include <stdexcept>
+#include <png.h>
+#include <fileio/ShapeFile.h>
+#include <fileio/MaskFile.h>
+
+/**
+ *  \brief Tests the labels read from a file
+ *
+ *  \param filename image file name
+ *  \param labels   expected labels, row wise
+ *
+ *  \return true if the file is read with the expected labels
+ */
+static bool SameLabels(const std::string &filename, const std::vector<unsigned char> &labels)
+{
+	shape::LabelShape<2>::Ptr labsh = fileio::ReadLabelShape(filename);
+	std::remove(filename.c_str());
+	return labsh && labsh->getContainer() == labels;
+}
+
+/**
+ *  \brief Tests if reading the labels of a file throws
+ *
+ *  \param filename image file name
+ *
+ *  \return true if reading the labels throws
+ */
+static bool RejectsLabels(const std::string &filename)
+{
+	bool thrown = false;
+	try
+	{
+		fileio::ReadLabelShape(filename);
+	}
+	catch(const std::logic_error &)
+	{
+		thrown = true;
+	}
+	std::remove(filename.c_str());
+	return thrown;
+}
+
+bool TestReadLabels()
+{
+	bool ok = true;
+	const std::string filename = "test_readlabels.img";
+
+	// PGM values are not rescaled to the maximal value
+	WriteFile(filename,std::string("P5\n4 1\n20\n") + std::string{0,1,2,20});
+	ok = Check(SameLabels(filename,{0,1,2,20}), "raw PGM labels") && ok;
+	WriteFile(filename,"P2\n2 2\n20\n0 1\n2 20\n");
+	ok = Check(SameLabels(filename,{0,1,2,20}), "plain PGM labels") && ok;
+	WriteFile(filename,"P5\n1 1\n300\n\x01\x2c");
+	ok = Check(RejectsLabels(filename), "PGM labels above 255") && ok;
+
+	// PBM bits are not inverted
+	WriteFile(filename,"P1\n3 1\n1 0 1\n");
+	ok = Check(SameLabels(filename,{1,0,1}), "plain PBM labels") && ok;
+	WriteFile(filename,std::string("P4\n3 1\n") + std::string(1,(char)0xa0));
+	ok = Check(SameLabels(filename,{1,0,1}), "raw PBM labels") && ok;
+
+	// palette indices are kept, even for entries of the same color
+	std::vector<unsigned char> palette{0,0,0, 100,100,100, 100,100,100, 255,0,0};
+	for(int bitdepth : {2,4,8})
+	{
+		for(bool interlaced : {false,true})
+		{
+			WritePNG(filename,3,2,{0,1,2,3,2,1},PNG_COLOR_TYPE_PALETTE,bitdepth,interlaced,palette);
+			ok = Check(SameLabels(filename,{0,1,2,3,2,1}), "palette PNG labels") && ok;
+		}
+	}
+
+	// transparent palette entries do not widen the rows, neither for labels nor for gray levels
+	std::vector<unsigned int> indices{0,1,2,3, 3,2,1,0, 0,0,1,1, 2,2,3,3};
+	for(bool interlaced : {false,true})
+	{
+		WritePNG(filename,4,4,indices,PNG_COLOR_TYPE_PALETTE,8,interlaced,palette,{0,128});
+		ok = Check(SameLabels(filename,std::vector<unsigned char>(indices.begin(),indices.end())), "palette PNG labels with transparency") && ok;
+		WritePNG(filename,4,4,indices,PNG_COLOR_TYPE_PALETTE,8,interlaced,palette,{0,128});
+		shape::DiscreteShape<2>::Ptr dissh = fileio::ReadShape(filename);
+		std::remove(filename.c_str());
+		bool same = dissh && dissh->getWidth() == 4 && dissh->getHeight() == 4;
+		for(unsigned int i = 0; same && i < indices.size(); i++)
+			same = (dissh->getData()[i % 4 + dissh->getStride() * (i / 4)] != 0) == (indices[i] != 0);
+		ok = Check(same, "palette PNG gray levels with transparency") && ok;
+	}
+
+	// gray PNG values are not expanded to 8 bits
+	WritePNG(filename,4,1,{0,1,2,3},PNG_COLOR_TYPE_GRAY,2);
+	ok = Check(SameLabels(filename,{0,1,2,3}), "2 bits gray PNG labels") && ok;
+	WritePNG(filename,2,1,{7,200},PNG_COLOR_TYPE_GRAY,8);
+	ok = Check(SameLabels(filename,{7,200}), "8 bits gray PNG labels") && ok;
+	WritePNG(filename,2,1,{7,0,200,255},PNG_COLOR_TYPE_GRAY_ALPHA,8);
+	ok = Check(SameLabels(filename,{7,200}), "gray PNG labels with alpha") && ok;
+	WritePNG(filename,1,1,{300},PNG_COLOR_TYPE_GRAY,16);
+	ok = Check(RejectsLabels(filename), "16 bits PNG labels") && ok;
+	WritePNG(filename,1,1,{1,2,3},PNG_COLOR_TYPE_RGB,8);
+	ok = Check(RejectsLabels(filename), "colored PNG labels") && ok;
+
+	// mask pixels are label 1
+	shape::DiscreteShape<2>::Ptr dissh(new shape::DiscreteShape<2>(3,1));
+	dissh->getWritableContainer()[1] = 255;
+	for(fileio::MaskEncoding encoding : {fileio::MaskEncoding::bytes, fileio::MaskEncoding::packed})
+	{
+		fileio::WriteMaskFile(dissh,filename,encoding);
+		ok = Check(SameLabels(filename,{0,1,0}), "mask file labels") && ok;
+	}
+
+	return ok;
+}
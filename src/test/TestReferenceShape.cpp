@@ -0,0 +1,103 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestReferenceShape.cpp
+ *  \brief Reference shape evaluation against the standalone errors
+ *  \author Bastien Durix
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <algorithm/evaluation/ShapeError.h>
+#include <algorithm/evaluation/ReferenceShape.h>
+#include <algorithm/extractboundary/BorderFollowing.h>
+#include "Tests.h"
+
+/**
+ *  \brief Tests if two errors are equal, NaN being equal to NaN
+ *
+ *  \param err1 first error
+ *  \param err2 second error
+ *
+ *  \return true if both errors are equal or both NaN
+ */
+static bool SameError(double err1, double err2)
+{
+	return err1 == err2 || (std::isnan(err1) && std::isnan(err2));
+}
+
+bool TestReferenceShape()
+{
+	using namespace algorithm::evaluation;
+	bool ok = true;
+
+	// random references, each evaluated against a batch of shapes, with and without distance maps
+	std::mt19937 gen(17);
+	for(unsigned int it = 0; it < 20 && ok; it++)
+	{
+		unsigned int width = 10 + gen() % 60, height = 10 + gen() % 60;
+		shape::DiscreteShape<2>::Ptr shpref = RandomDisks(gen,width,height,1 + gen() % 6);
+		std::vector<shape::DiscreteShape<2>::Ptr> vecshp(8);
+		for(unsigned int i = 0; i < vecshp.size(); i++)
+			vecshp[i] = i % 4 == 3 ? RandomShape(gen,width,height,gen() % 20) : RandomDisks(gen,width,height,gen() % 6);
+
+		boundary::DiscreteBoundary<2>::Ptr bndref = algorithm::extractboundary::BorderFollowing(shpref);
+		DistanceMap dismapref(shpref);
+		for(bool distmap : {false,true})
+		{
+			ReferenceShape reference(shpref,OptionsReference(distmap));
+			std::vector<ReferenceShape::Errors> vecerr = reference.evaluate(vecshp);
+			ok = Check(vecerr.size() == vecshp.size(), "one error per evaluated shape") && ok;
+			for(unsigned int i = 0; i < vecerr.size() && i < vecshp.size(); i++)
+			{
+				ok = Check(SameError(vecerr[i].symdiff,SymDiffArea(shpref,vecshp[i])), "reference SymDiffArea differs from the standalone one") && ok;
+				ok = Check(vecerr[i].hausdist == HausDist(bndref,algorithm::extractboundary::BorderFollowing(vecshp[i])), "reference HausDist differs from the standalone one") && ok;
+				if(distmap)
+				{
+					DistanceMap dismap(vecshp[i]);
+					ok = Check(vecerr[i].hausdistdt == HausDist(dismapref,dismap), "reference distance map HausDist differs from the standalone one") && ok;
+					ok = Check(vecerr[i].avgsurfdist == AvgSurfDist(dismapref,dismap), "reference AvgSurfDist differs from the standalone one") && ok;
+				}
+				else
+					ok = Check(std::isnan(vecerr[i].hausdistdt) && std::isnan(vecerr[i].avgsurfdist), "distance map errors computed without distance maps") && ok;
+			}
+		}
+	}
+
+	// a shape of another size makes the whole batch throw, out of the parallel loop
+	shape::DiscreteShape<2>::Ptr shpref = RandomDisks(gen,30,20,3);
+	std::vector<shape::DiscreteShape<2>::Ptr> vecshp{RandomDisks(gen,30,20,3),RandomDisks(gen,20,30,3),RandomDisks(gen,30,20,3)};
+	bool thrown = false;
+	try
+	{
+		ReferenceShape(shpref).evaluate(vecshp);
+	}
+	catch(const std::logic_error &)
+	{
+		thrown = true;
+	}
+	ok = Check(thrown, "evaluation of a shape of another size") && ok;
+
+	return ok;
+}
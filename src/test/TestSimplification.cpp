@@ -0,0 +1,75 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestSimplification.cpp
+ *  \brief Douglas-Peucker simplification and simplified Hausdorff distance within tolerance
+ *  \author Bastien Durix
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <algorithm/evaluation/ShapeError.h>
+#include <algorithm/evaluation/SegmentBVH.h>
+#include <algorithm/extractboundary/BorderFollowing.h>
+#include <algorithm/simplification/DouglasPeucker.h>
+#include "Tests.h"
+
+bool TestSimplification()
+{
+	using namespace algorithm::evaluation;
+	bool ok = true;
+
+	// tolerances below and above the crack length, on smooth boundaries with holes
+	std::mt19937 gen(11);
+	for(unsigned int it = 0; it < 200 && ok; it++)
+	{
+		unsigned int width = 10 + gen() % 60, height = 10 + gen() % 60;
+		boundary::DiscreteBoundary<2>::Ptr bnd1 = algorithm::extractboundary::BorderFollowing(RandomDisks(gen,width,height,1 + gen() % 6));
+		boundary::DiscreteBoundary<2>::Ptr bnd2 = algorithm::extractboundary::BorderFollowing(RandomDisks(gen,width,height,1 + gen() % 6));
+		double tolerance = 0.25 * (double)(1 + gen() % 16);
+
+		boundary::DiscreteBoundary<2>::Ptr simpl = algorithm::simplification::DouglasPeucker(bnd1,tolerance);
+		ok = Check(simpl->getNbVertices() <= bnd1->getNbVertices(), "simplification adds vertices") && ok;
+		ok = Check(bnd1->getNbVertices() == 0 || tolerance < 1.0 || simpl->getNbVertices() < bnd1->getNbVertices(), "simplification keeps every crack corner") && ok;
+		ok = Check(HausDistSegments(bnd1,simpl) <= tolerance + 1e-9, "simplified boundary out of tolerance") && ok;
+
+		double dist = HausDistSegments(bnd1,bnd2);
+		double distsimpl = HausDistSimplified(bnd1,bnd2,tolerance);
+		ok = Check(dist == distsimpl || std::abs(distsimpl - dist) <= tolerance + 1e-9, "simplified HausDist out of tolerance") && ok;
+	}
+
+	// segments need both extremities
+	bool thrown = false;
+	try
+	{
+		SegmentBVH bvh(std::vector<Eigen::Vector2d>(3,Eigen::Vector2d::Zero()),std::vector<Eigen::Vector2d>(2,Eigen::Vector2d::Zero()));
+	}
+	catch(const std::logic_error &)
+	{
+		thrown = true;
+	}
+	ok = Check(thrown, "segments with a missing extremity") && ok;
+
+	return ok;
+}
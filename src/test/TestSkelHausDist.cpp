@@ -0,0 +1,76 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestSkelHausDist.cpp
+ *  \brief Skeleton to boundary Hausdorff distance against a linear search over the disks
+ *  \author Bastien Durix
+ */
+
+#include <list>
+#include <algorithm/evaluation/ShapeError.h>
+#include <mathtools/geometry/euclidian/HyperSphere.h>
+#include "Tests.h"
+
+bool TestSkelHausDist()
+{
+	using namespace algorithm::evaluation;
+	using Sphere = mathtools::geometry::euclidian::HyperSphere<2>;
+	bool ok = true;
+
+	std::mt19937 gen(2);
+	std::uniform_real_distribution<double> coord(0.0,200.0), radius(0.0,10.0);
+	mathtools::affine::Frame<2>::Ptr frame = mathtools::affine::Frame<2>::CreateFrame(Eigen::Vector2d(3.0,-2.0),Eigen::Vector2d(1.0,0.2),Eigen::Vector2d(-0.1,1.0));
+	for(unsigned int it = 0; it < 100 && ok; it++)
+	{
+		skeleton::GraphSkel2d::Ptr grskl(new skeleton::GraphSkel2d(skeleton::model::Classic<2>()));
+		unsigned int nbnod = 1 + gen() % 300;
+		for(unsigned int i = 0; i < nbnod; i++)
+			grskl->addNode<Sphere>(Sphere(mathtools::affine::Point<2>(coord(gen),coord(gen)),radius(gen)));
+
+		boundary::DiscreteBoundary<2>::Ptr bnd = RandomBoundary(gen,1 + gen() % 3,200,200);
+
+		// distance of each vertex to the nearest disk, all disks being visited
+		std::list<unsigned int> lnod;
+		std::list<Sphere> lsph;
+		grskl->getAllNodes(lnod);
+		grskl->getNodes<Sphere,std::list<unsigned int>,std::list<Sphere> >(lnod,lsph);
+		double distmax = 0.0;
+		for(unsigned int i = 0; i < bnd->getNbVertices(); i++)
+		{
+			Eigen::Vector2d pt = bnd->getVertex(i).getCoords();
+			double distmin = -1.0;
+			for(const Sphere &sph : lsph)
+			{
+				double dist = std::max((pt - sph.getCenter().getCoords(frame)).norm() - sph.getRadius(), 0.0);
+				if(distmin < 0.0 || dist < distmin)
+					distmin = dist;
+			}
+			distmax = std::max(distmax,distmin);
+		}
+
+		ok = Check(HausDist(grskl,bnd,frame) == distmax, "skeleton HausDist differs from the linear search") && ok;
+	}
+
+	return ok;
+}
@@ -0,0 +1,69 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestStreamError.cpp
+ *  \brief Streaming evaluation against the evaluation of loaded shapes
+ *  \author Bastien Durix
+ */
+
+#include <cmath>
+#include <limits>
+#include <shape/PackedShape.h>
+#include <algorithm/evaluation/StreamError.h>
+#include <algorithm/evaluation/ShapeError.h>
+#include <algorithm/evaluation/BoundaryGrid.h>
+#include <algorithm/extractboundary/BorderFollowing.h>
+#include "Tests.h"
+
+bool TestStreamError()
+{
+	using namespace algorithm::evaluation;
+	bool ok = true;
+
+	// band heights from one row to more than the shape, so that boundaries cross band edges
+	std::mt19937 gen(4);
+	for(unsigned int it = 0; it < 1000 && ok; it++)
+	{
+		unsigned int width = 1 + gen() % 40, height = 1 + gen() % 40;
+		shape::DiscreteShape<2>::Ptr shpref = RandomShape(gen,width,height,it % 10 == 0 ? 0 : gen() % 100);
+		shape::DiscreteShape<2>::Ptr shpcmp = RandomShape(gen,width,height,it % 10 == 5 ? 0 : gen() % 100);
+		OptionsStream options(1 + gen() % 50);
+
+		StreamErrors err = StreamError(shape::RowStream::Ptr(new shape::DiscreteRowStream(shpref)),shape::RowStream::Ptr(new shape::DiscreteRowStream(shpcmp)),options);
+		double symdiff = SymDiffArea(shape::PackedShape<2>::Ptr(new shape::PackedShape<2>(shpref)),shape::PackedShape<2>::Ptr(new shape::PackedShape<2>(shpcmp)));
+		double hausdist = HausDist(BoundaryGrid(algorithm::extractboundary::BorderFollowing(shpref)),BoundaryGrid(algorithm::extractboundary::BorderFollowing(shpcmp)));
+		ok = Check(err.symdiff == symdiff || (std::isnan(symdiff) && std::isnan(err.symdiff)), "streamed symmetric difference differs") && ok;
+		ok = Check(err.hausdist == hausdist, "streamed Hausdorff distance differs") && ok;
+
+		double symdiffonly = SymDiffArea(shape::RowStream::Ptr(new shape::DiscreteRowStream(shpref)),shape::RowStream::Ptr(new shape::DiscreteRowStream(shpcmp)),options);
+		ok = Check(symdiffonly == symdiff || (std::isnan(symdiff) && std::isnan(symdiffonly)), "streamed symmetric difference alone differs") && ok;
+	}
+
+	// a shape missing on one side
+	shape::DiscreteShape<2>::Ptr full = RandomShape(gen,20,20,100), empty = RandomShape(gen,20,20,0);
+	StreamErrors err = StreamError(shape::RowStream::Ptr(new shape::DiscreteRowStream(full)),shape::RowStream::Ptr(new shape::DiscreteRowStream(empty)));
+	ok = Check(err.symdiff == 1.0 && err.hausdist == std::numeric_limits<double>::infinity(), "streamed errors against an empty shape") && ok;
+
+	return ok;
+}
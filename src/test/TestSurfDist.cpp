@@ -0,0 +1,134 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestSurfDist.cpp
+ *  \brief Surface distances against the sorted distances of each vertex
+ *  \author Bastien Durix
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <algorithm/evaluation/ShapeError.h>
+#include <algorithm/evaluation/BoundaryGrid.h>
+#include "Tests.h"
+
+/**
+ *  \brief Distances of the vertices of a boundary to the vertices of another one, by brute force
+ *
+ *  \param bndfrom boundary whose vertices are measured
+ *  \param bndto   boundary whose vertices are searched
+ *  \param dist    vector the distances are appended to
+ */
+static void VerticesDistances(const boundary::DiscreteBoundary<2>::Ptr bndfrom, const boundary::DiscreteBoundary<2>::Ptr bndto, std::vector<double> &dist)
+{
+	boundary::DiscreteBoundary<2>::VerticesView vertfrom = bndfrom->getView();
+	boundary::DiscreteBoundary<2>::VerticesView vertto = bndto->getView();
+	for(unsigned int i = 0; i < vertfrom.size; i++)
+	{
+		double sqdist = std::numeric_limits<double>::infinity();
+		for(unsigned int j = 0; j < vertto.size; j++)
+		{
+			double dx = vertfrom.x[i] - vertto.x[j], dy = vertfrom.y[i] - vertto.y[j];
+			sqdist = std::min(sqdist, dx*dx + dy*dy);
+		}
+		dist.push_back(std::sqrt(sqdist));
+	}
+}
+
+/**
+ *  \brief Tests if the surface distances options are rejected
+ *
+ *  \param bnd     boundary the distances are computed on
+ *  \param options surface distances options
+ *
+ *  \return true if SurfDist throws
+ */
+static bool RejectsOptions(const boundary::DiscreteBoundary<2>::Ptr bnd, const algorithm::evaluation::OptionsSurfDist &options)
+{
+	try
+	{
+		algorithm::evaluation::SurfDist(bnd,bnd,options);
+	}
+	catch(const std::logic_error &)
+	{
+		return true;
+	}
+	return false;
+}
+
+bool TestSurfDist()
+{
+	using namespace algorithm::evaluation;
+	bool ok = true;
+
+	// random boundaries, the histogram percentile is at most one bin above the nearest rank one
+	std::mt19937 gen(16);
+	for(unsigned int it = 0; it < 200 && ok; it++)
+	{
+		unsigned int range = 1 + gen() % (it % 2 == 0 ? 10 : 500);
+		boundary::DiscreteBoundary<2>::Ptr bnd1 = RandomBoundary(gen,1 + gen() % 3,200,range);
+		boundary::DiscreteBoundary<2>::Ptr bnd2 = RandomBoundary(gen,1 + gen() % 3,200,range * (1 + it % 4));
+
+		std::vector<double> dist(0);
+		VerticesDistances(bnd1,bnd2,dist);
+		VerticesDistances(bnd2,bnd1,dist);
+		std::sort(dist.begin(),dist.end());
+		double distsum = 0.0;
+		for(double d : dist)
+			distsum += d;
+
+		for(double binwidth : {0.01,0.1,1.0,10.0})
+		{
+			for(double percentile : {0.0,50.0,95.0,100.0})
+			{
+				unsigned int rank = std::max((unsigned int)std::ceil(percentile / 100.0 * (double)dist.size()),1u);
+				SurfDistances surf = SurfDist(BoundaryGrid(bnd1),BoundaryGrid(bnd2),OptionsSurfDist(percentile,binwidth));
+				ok = Check(surf.hausdist == dist.back(), "SurfDist Hausdorff distance differs from brute force") && ok;
+				ok = Check(surf.pcthausdist >= dist[rank-1] && surf.pcthausdist <= dist[rank-1] + binwidth, "SurfDist percentile out of the bin width") && ok;
+				ok = Check(std::abs(surf.avgsurfdist - distsum / (double)dist.size()) <= 1e-9 * (1.0 + distsum), "SurfDist average distance differs from brute force") && ok;
+			}
+		}
+	}
+
+	// empty boundaries
+	const double inf = std::numeric_limits<double>::infinity();
+	boundary::DiscreteBoundary<2>::Ptr empty(new boundary::DiscreteBoundary<2>());
+	boundary::DiscreteBoundary<2>::Ptr bnd = RandomBoundary(gen,1,20,10);
+	SurfDistances surf = SurfDist(empty,empty);
+	ok = Check(surf.hausdist == 0.0 && surf.pcthausdist == 0.0 && surf.avgsurfdist == 0.0, "SurfDist between empty boundaries") && ok;
+	surf = SurfDist(bnd,empty);
+	ok = Check(surf.hausdist == inf && surf.pcthausdist == inf && surf.avgsurfdist == inf, "SurfDist to an empty boundary") && ok;
+	surf = SurfDist(empty,bnd);
+	ok = Check(surf.hausdist == inf && surf.pcthausdist == inf && surf.avgsurfdist == inf, "SurfDist from an empty boundary") && ok;
+
+	// invalid options
+	ok = Check(RejectsOptions(bnd,OptionsSurfDist(95.0,0.0)), "SurfDist with a null bin width") && ok;
+	ok = Check(RejectsOptions(bnd,OptionsSurfDist(95.0,-1.0)), "SurfDist with a negative bin width") && ok;
+	ok = Check(RejectsOptions(bnd,OptionsSurfDist(-1.0,0.1)), "SurfDist with a negative percentile") && ok;
+	ok = Check(RejectsOptions(bnd,OptionsSurfDist(101.0,0.1)), "SurfDist with a percentile above 100") && ok;
+
+	return ok;
+}
@@ -0,0 +1,52 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestTiledBorder.cpp
+ *  \brief Tiled border following against the sequential one
+ *  \author Bastien Durix
+ */
+
+#include <algorithm/extractboundary/BorderFollowing.h>
+#include "Tests.h"
+
+bool TestTiledBorder()
+{
+	bool ok = true;
+
+	// from one band to more bands than lines, so that chains cross several seams
+	std::mt19937 gen(7);
+	for(unsigned int it = 0; it < 3000 && ok; it++)
+	{
+		unsigned int width = 1 + gen() % 30, height = 1 + gen() % 30;
+		shape::DiscreteShape<2>::Ptr dissh = RandomShape(gen,width,height,gen() % 100);
+
+		boundary::DiscreteBoundary<2>::Ptr bnd = algorithm::extractboundary::BorderFollowing(dissh);
+		boundary::DiscreteBoundary<2>::Ptr tiled = algorithm::extractboundary::TiledBorderFollowing(dissh,1 + gen() % 40);
+		ok = Check(tiled->getNbVertices() == bnd->getNbVertices(), "tiled border following size differs") && ok;
+		for(unsigned int i = 0; i < bnd->getNbVertices() && ok; i++)
+			ok = Check(tiled->getCoordinates(i) == bnd->getCoordinates(i) && tiled->getNext(i) == bnd->getNext(i), "tiled border following differs") && ok;
+	}
+
+	return ok;
+}
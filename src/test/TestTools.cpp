@@ -0,0 +1,145 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file TestTools.cpp
+ *  \brief Random shapes and boundaries for the regression tests
+ *  \author Bastien Durix
+ */
+
+#include "Tests.h"
+#include <cstdio>
+#include <algorithm>
+#include <stdexcept>
+#include <png.h>
+
+bool Check(bool ok, const std::string &message)
+{
+	if(!ok)
+		std::cerr << "FAILED : " << message << std::endl;
+	return ok;
+}
+
+shape::DiscreteShape<2>::Ptr RandomShape(std::mt19937 &gen, unsigned int width, unsigned int height, unsigned int density)
+{
+	shape::DiscreteShape<2>::Ptr dissh(new shape::DiscreteShape<2>(width,height));
+	std::vector<unsigned char> &disc = dissh->getWritableContainer();
+	for(unsigned int i = 0; i < disc.size(); i++)
+		disc[i] = gen() % 100 < density ? 255 : 0;
+	return dissh;
+}
+
+shape::DiscreteShape<2>::Ptr RandomDisks(std::mt19937 &gen, unsigned int width, unsigned int height, unsigned int nbdisks)
+{
+	shape::DiscreteShape<2>::Ptr dissh(new shape::DiscreteShape<2>(width,height));
+	std::vector<unsigned char> &disc = dissh->getWritableContainer();
+	for(unsigned int k = 0; k < nbdisks; k++)
+	{
+		double cx = (double)(gen() % (width + 1)), cy = (double)(gen() % (height + 1));
+		double radius = 1.0 + (double)(gen() % (1 + std::max(width,height) / 3));
+		for(unsigned int l = 0; l < height; l++)
+			for(unsigned int c = 0; c < width; c++)
+				if((c + 0.5 - cx) * (c + 0.5 - cx) + (l + 0.5 - cy) * (l + 0.5 - cy) <= radius * radius)
+					disc[c + width * l] ^= 255;
+	}
+	return dissh;
+}
+
+boundary::DiscreteBoundary<2>::Ptr RandomBoundary(std::mt19937 &gen, unsigned int nbloops, unsigned int nbvert, unsigned int range)
+{
+	boundary::DiscreteBoundary<2>::Ptr bnd(new boundary::DiscreteBoundary<2>());
+	std::uniform_int_distribution<unsigned int> coord(0,range);
+	for(unsigned int k = 0; k < nbloops; k++)
+	{
+		std::vector<Eigen::Vector2d> vec_vert(1 + gen() % nbvert);
+		for(unsigned int i = 0; i < vec_vert.size(); i++)
+			vec_vert[i] = Eigen::Vector2d((double)coord(gen),(double)coord(gen));
+		bnd->addVerticesVector(vec_vert);
+	}
+	return bnd;
+}
+
+void WriteFile(const std::string &filename, const std::string &content)
+{
+	FILE *file = std::fopen(filename.c_str(),"wb");
+	if(!file)
+		throw std::logic_error("WriteFile : cannot open " + filename);
+	std::fwrite(content.data(),1,content.size(),file);
+	std::fclose(file);
+}
+
+void WritePNG(const std::string &filename, unsigned int width, unsigned int height, const std::vector<unsigned int> &samples,
+			  int colortype, int bitdepth, bool interlaced, const std::vector<unsigned char> &palette, const std::vector<unsigned char> &trans)
+{
+	FILE *file = std::fopen(filename.c_str(),"wb");
+	if(!file)
+		throw std::logic_error("WritePNG : cannot open " + filename);
+
+	png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING,nullptr,nullptr,nullptr);
+	png_infop info = png_create_info_struct(png);
+	if(setjmp(png_jmpbuf(png)))
+	{
+		png_destroy_write_struct(&png,&info);
+		std::fclose(file);
+		throw std::logic_error("WritePNG : cannot write " + filename);
+	}
+	png_init_io(png,file);
+	png_set_IHDR(png,info,width,height,bitdepth,colortype,interlaced ? PNG_INTERLACE_ADAM7 : PNG_INTERLACE_NONE,
+				 PNG_COMPRESSION_TYPE_DEFAULT,PNG_FILTER_TYPE_DEFAULT);
+	if(colortype == PNG_COLOR_TYPE_PALETTE)
+	{
+		std::vector<png_color> plte(palette.size()/3);
+		for(unsigned int i = 0; i < plte.size(); i++)
+			plte[i] = png_color{palette[3*i],palette[3*i+1],palette[3*i+2]};
+		png_set_PLTE(png,info,plte.data(),plte.size());
+		if(trans.size() != 0)
+			png_set_tRNS(png,info,trans.data(),trans.size(),nullptr);
+	}
+	png_write_info(png,info);
+
+	// one byte per sample below 8 bits, packed by libpng
+	if(bitdepth < 8)
+		png_set_packing(png);
+
+	unsigned int nbsamples = samples.size() / (width * height);
+	unsigned int bytes = bitdepth == 16 ? 2 : 1;
+	std::vector<unsigned char> data((std::size_t)samples.size() * bytes);
+	for(unsigned int i = 0; i < samples.size(); i++)
+	{
+		if(bytes == 2)
+		{
+			data[2*i] = samples[i] >> 8;
+			data[2*i+1] = samples[i] & 255;
+		}
+		else
+			data[i] = samples[i];
+	}
+	std::vector<png_bytep> rows(height);
+	for(unsigned int l = 0; l < height; l++)
+		rows[l] = &data[(std::size_t)width * nbsamples * bytes * l];
+	png_write_image(png,rows.data());
+	png_write_end(png,nullptr);
+
+	png_destroy_write_struct(&png,&info);
+	std::fclose(file);
+}
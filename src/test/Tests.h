@@ -0,0 +1,254 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file Tests.h
+ *  \brief Regression tests of the evaluation library
+ *  \author Bastien Durix
+ */
+
+#ifndef _TESTS_H_
+#define _TESTS_H_
+
+#include <random>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <shape/DiscreteShape.h>
+#include <boundary/DiscreteBoundary2.h>
+
+/**
+ *  \brief Reports a failed check
+ *
+ *  \param ok      checked condition
+ *  \param message message displayed if the check fails
+ *
+ *  \return ok
+ */
+bool Check(bool ok, const std::string &message);
+
+/**
+ *  \brief Random discrete shape
+ *
+ *  \param gen     random generator
+ *  \param width   width of the shape
+ *  \param height  height of the shape
+ *  \param density percentage of pixels in the shape
+ *
+ *  \return shape whose pixels are 255 with probability density, 0 otherwise
+ */
+shape::DiscreteShape<2>::Ptr RandomShape(std::mt19937 &gen, unsigned int width, unsigned int height, unsigned int density);
+
+/**
+ *  \brief Random shape made of overlapping disks
+ *
+ *  \details Pixels covered by an odd number of disks are in the shape, so that the shape has smooth
+ *           boundaries, holes and components nested in the holes
+ *
+ *  \param gen     random generator
+ *  \param width   width of the shape
+ *  \param height  height of the shape
+ *  \param nbdisks number of disks
+ *
+ *  \return shape whose pixels are 255 in the shape, 0 otherwise
+ */
+shape::DiscreteShape<2>::Ptr RandomDisks(std::mt19937 &gen, unsigned int width, unsigned int height, unsigned int nbdisks);
+
+/**
+ *  \brief Random boundary, with integer coordinates
+ *
+ *  \param gen     random generator
+ *  \param nbloops number of loops
+ *  \param nbvert  maximal number of vertices per loop
+ *  \param range   maximal coordinate
+ *
+ *  \return boundary
+ */
+boundary::DiscreteBoundary<2>::Ptr RandomBoundary(std::mt19937 &gen, unsigned int nbloops, unsigned int nbvert, unsigned int range);
+
+/**
+ *  \brief Writes a file
+ *
+ *  \param filename file name
+ *  \param content  bytes of the file
+ */
+void WriteFile(const std::string &filename, const std::string &content);
+
+/**
+ *  \brief Writes a PNG image
+ *
+ *  \param filename   file name
+ *  \param width      image width
+ *  \param height     image height
+ *  \param samples    samples of the image, row wise, one per channel of each pixel
+ *  \param colortype  PNG color type
+ *  \param bitdepth   bits per sample
+ *  \param interlaced true to write an interlaced image
+ *  \param palette    RGB palette, 3 values per entry, for palette images
+ *  \param trans      alpha values of the first palette entries, written in a tRNS chunk if not empty
+ */
+void WritePNG(const std::string &filename, unsigned int width, unsigned int height, const std::vector<unsigned int> &samples,
+			  int colortype, int bitdepth, bool interlaced = false, const std::vector<unsigned char> &palette = std::vector<unsigned char>(0),
+			  const std::vector<unsigned char> &trans = std::vector<unsigned char>(0));
+
+/**
+ *  \brief Indexed Hausdorff distance against brute force, ties and empty boundaries
+ *
+ *  \return true if the test passes
+ */
+bool TestHausDist();
+
+/**
+ *  \brief Surface distances against the sorted distances of each vertex, and empty boundaries
+ *
+ *  \return true if the test passes
+ */
+bool TestSurfDist();
+
+/**
+ *  \brief Distance transform and its Hausdorff distance against brute force
+ *
+ *  \return true if the test passes
+ */
+bool TestDistanceMap();
+
+/**
+ *  \brief Coarse to fine Hausdorff distance against the distance transform one
+ *
+ *  \return true if the test passes
+ */
+bool TestMultiRes();
+
+/**
+ *  \brief Early break Hausdorff distance against brute force
+ *
+ *  \return true if the test passes
+ */
+bool TestEarlyBreak();
+
+/**
+ *  \brief Skeleton to boundary Hausdorff distance against a linear search over the disks
+ *
+ *  \return true if the test passes
+ */
+bool TestSkelHausDist();
+
+/**
+ *  \brief Douglas-Peucker simplification and simplified Hausdorff distance within tolerance
+ *
+ *  \return true if the test passes
+ */
+bool TestSimplification();
+
+/**
+ *  \brief Border following against the naive boundary extraction
+ *
+ *  \return true if the test passes
+ */
+bool TestBorderFollowing();
+
+/**
+ *  \brief Tiled border following against the sequential one
+ *
+ *  \return true if the test passes
+ */
+bool TestTiledBorder();
+
+/**
+ *  \brief Contour areas, region areas and intersection over union against pixel counts
+ *
+ *  \return true if the test passes
+ */
+bool TestContourArea();
+
+/**
+ *  \brief Marching squares loops and areas against border following on a fixture
+ *
+ *  \return true if the test passes
+ */
+bool TestMarchingSquares();
+
+/**
+ *  \brief Run length encoded shape operations against the dense ones
+ *
+ *  \return true if the test passes
+ */
+bool TestRLEShape();
+
+/**
+ *  \brief Streaming evaluation against the evaluation of loaded shapes
+ *
+ *  \return true if the test passes
+ */
+bool TestStreamError();
+
+/**
+ *  \brief Multi-label evaluation against the evaluation of each binarized label
+ *
+ *  \return true if the test passes
+ */
+bool TestLabelError();
+
+/**
+ *  \brief Cached bounding box of discrete shapes
+ *
+ *  \return true if the test passes
+ */
+bool TestBoundingBox();
+
+/**
+ *  \brief Reads mask files in both encodings through the generic shape readers
+ *
+ *  \return true if the test passes
+ */
+bool TestMaskFile();
+
+/**
+ *  \brief Raw label values read from PBM, PGM, palette PNG and mask files
+ *
+ *  \return true if the test passes
+ */
+bool TestReadLabels();
+
+/**
+ *  \brief Images in formats decoded by OpenCV, read and evaluated like PGM images
+ *
+ *  \return true if the test passes
+ */
+bool TestReadImage();
+
+/**
+ *  \brief Reference shape evaluation against the standalone errors, and shapes of another size
+ *
+ *  \return true if the test passes
+ */
+bool TestReferenceShape();
+
+/**
+ *  \brief Metric set against the standalone errors and pixel counts
+ *
+ *  \return true if the test passes
+ */
+bool TestMetricSet();
+
+#endif //_TESTS_H_
@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file main.cpp
+ *  \brief Runs the regression tests
+ *  \author Bastien Durix
+ */
+
+#include <cstring>
+#include "Tests.h"
+
+/**
+ *  \brief Named regression test
+ */
+struct NamedTest
+{
+	/**
+	 *  \brief Test name, given on the command line
+	 */
+	const char *name;
+
+	/**
+	 *  \brief Test function
+	 */
+	bool (*test)();
+};
+
+int main(int argc, char** argv)
+{
+	const NamedTest tests[] = {
+		{"hausdist", TestHausDist},
+		{"surfdist", TestSurfDist},
+		{"distancemap", TestDistanceMap},
+		{"multires", TestMultiRes},
+		{"earlybreak", TestEarlyBreak},
+		{"skelhausdist", TestSkelHausDist},
+		{"simplification", TestSimplification},
+		{"borderfollowing", TestBorderFollowing},
+		{"tiledborder", TestTiledBorder},
+		{"contourarea", TestContourArea},
+		{"marchingsquares", TestMarchingSquares},
+		{"rleshape", TestRLEShape},
+		{"streamerror", TestStreamError},
+		{"labelerror", TestLabelError},
+		{"boundingbox", TestBoundingBox},
+		{"maskfile", TestMaskFile},
+		{"readlabels", TestReadLabels},
+		{"readimage", TestReadImage},
+		{"referenceshape", TestReferenceShape},
+		{"metricset", TestMetricSet}
+	};
+
+	// runs the test given as argument, or all of them
+	bool ok = true, found = false;
+	for(const NamedTest &test : tests)
+	{
+		if(argc > 1 && std::strcmp(argv[1],test.name) != 0)
+			continue;
+		found = true;
+		bool okcur = test.test();
+		std::cout << test.name << (okcur ? " : passed" : " : FAILED") << std::endl;
+		ok = ok && okcur;
+	}
+
+	if(!found)
+	{
+		std::cerr << "Unknown test " << argv[1] << std::endl;
+		return 1;
+	}
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,311 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file MaskFile.cpp
+ *  \brief Defines the native mask file format, read by memory mapping
+ *  \author Bastien Durix
+ */
+
+#include "MaskFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ *  \brief Mask file header
+ */
+struct MaskHeader
+{
+	/**
+	 *  \brief Magic characters, "EVSK"
+	 */
+	char magic[4];
+
+	/**
+	 *  \brief Format version
+	 */
+	uint32_t version;
+
+	/**
+	 *  \brief Shape width
+	 */
+	uint32_t width;
+
+	/**
+	 *  \brief Shape height
+	 */
+	uint32_t height;
+
+	/**
+	 *  \brief Pixels encoding
+	 */
+	uint32_t encoding;
+
+	/**
+	 *  \brief Reserved, zero
+	 */
+	uint32_t reserved;
+
+	/**
+	 *  \brief Frame origin, then first and second basis vectors
+	 */
+	double frame[6];
+};
+
+static_assert(sizeof(MaskHeader) == 72, "mask header has to be packed, rows of words start aligned");
+
+/**
+ *  \brief Current version of the format
+ */
+static const uint32_t MaskVersion = 1;
+
+/**
+ *  \brief Memory mapped file, unmapped at destruction
+ */
+struct MaskMapping
+{
+	/**
+	 *  \brief Mapped address
+	 */
+	void *addr;
+
+	/**
+	 *  \brief Mapped size
+	 */
+	std::size_t size;
+
+	/**
+	 *  \brief Destructor
+	 */
+	~MaskMapping()
+	{
+		munmap(addr,size);
+	}
+};
+
+/**
+ *  \brief Builds a mask file header
+ *
+ *  \param width    shape width
+ *  \param height   shape height
+ *  \param frame    shape frame
+ *  \param encoding pixels encoding
+ *
+ *  \return header
+ */
+static MaskHeader BuildHeader(unsigned int width, unsigned int height, const mathtools::affine::Frame<2>::Ptr frame, fileio::MaskEncoding encoding)
+{
+	MaskHeader header;
+	std::memcpy(header.magic,"EVSK",4);
+	header.version = MaskVersion;
+	header.width = width;
+	header.height = height;
+	header.encoding = (uint32_t)encoding;
+	header.reserved = 0;
+	
+	const Eigen::Matrix2d &basis = frame->getBasis()->getMatrix();
+	header.frame[0] = frame->getOrigin().x();
+	header.frame[1] = frame->getOrigin().y();
+	header.frame[2] = basis(0,0);
+	header.frame[3] = basis(1,0);
+	header.frame[4] = basis(0,1);
+	header.frame[5] = basis(1,1);
+
+	return header;
+}
+
+/**
+ *  \brief Maps a mask file
+ *
+ *  \param filename mask filename
+ *  \param encoding expected pixels encoding
+ *  \param header   header of the file, set
+ *
+ *  \return mapping of the file, null if the file cannot be opened
+ */
+static std::shared_ptr<MaskMapping> MapFile(const std::string &filename, fileio::MaskEncoding encoding, MaskHeader &header)
+{
+	std::shared_ptr<MaskMapping> mapping;
+
+	int fd = open(filename.c_str(),O_RDONLY);
+	if(fd == -1)
+		return mapping;
+	
+	struct stat st;
+	if(fstat(fd,&st) == -1 || (std::size_t)st.st_size < sizeof(MaskHeader))
+	{
+		close(fd);
+		throw std::logic_error("fileio::MapMaskFile : not a mask file");
+	}
+
+	// private writable mapping: the shape can be modified without touching the file
+	void *addr = mmap(nullptr,st.st_size,PROT_READ | PROT_WRITE,MAP_PRIVATE,fd,0);
+	close(fd);
+	if(addr == MAP_FAILED)
+		throw std::logic_error("fileio::MapMaskFile : mapping failed");
+	mapping = std::shared_ptr<MaskMapping>(new MaskMapping{addr,(std::size_t)st.st_size});
+
+	std::memcpy(&header,addr,sizeof(MaskHeader));
+	if(std::memcmp(header.magic,"EVSK",4) != 0 || header.version != MaskVersion)
+		throw std::logic_error("fileio::MapMaskFile : not a mask file");
+	if(header.encoding != (uint32_t)encoding)
+		throw std::logic_error("fileio::MapMaskFile : wrong pixels encoding");
+
+	std::size_t rowbytes = encoding == fileio::MaskEncoding::packed ? 8 * (((std::size_t)header.width+63)/64) : header.width;
+	if(mapping->size < sizeof(MaskHeader) + rowbytes * header.height)
+		throw std::logic_error("fileio::MapMaskFile : truncated file");
+
+	return mapping;
+}
+
+/**
+ *  \brief Frame of a mask file
+ *
+ *  \param header header of the file
+ *
+ *  \return frame of the shape
+ */
+static mathtools::affine::Frame<2>::Ptr HeaderFrame(const MaskHeader &header)
+{
+	return mathtools::affine::Frame<2>::CreateFrame(Eigen::Vector2d(header.frame[0],header.frame[1]),
+													Eigen::Vector2d(header.frame[2],header.frame[3]),
+													Eigen::Vector2d(header.frame[4],header.frame[5]));
+}
+
+void fileio::WriteMaskFile(const shape::DiscreteShape<2>::Ptr dissh, const std::string &filename, MaskEncoding encoding)
+{
+	FILE *file = std::fopen(filename.c_str(),"wb");
+	if(!file)
+		throw std::logic_error("fileio::WriteMaskFile : cannot open " + filename);
+
+	const shape::DiscreteShape<2> &shp = *dissh;
+	MaskHeader header = BuildHeader(shp.getWidth(),shp.getHeight(),shp.getFrame(),encoding);
+	bool ok = std::fwrite(&header,sizeof(MaskHeader),1,file) == 1;
+
+	const unsigned int rowwords = (shp.getWidth()+63)/64;
+	std::vector<unsigned char> rowbytes(shp.getWidth());
+	std::vector<uint64_t> words(rowwords);
+	for(unsigned int l = 0; l < shp.getHeight() && ok; l++)
+	{
+		const unsigned char *row = shp.getData() + shp.getStride() * l;
+		if(encoding == MaskEncoding::packed)
+		{
+			std::fill(words.begin(),words.end(),0);
+			for(unsigned int c = 0; c < shp.getWidth(); c++)
+				words[c/64] |= (uint64_t)(row[c] != 0) << (c%64);
+			ok = std::fwrite(words.data(),sizeof(uint64_t),rowwords,file) == rowwords;
+		}
+		else
+		{
+			for(unsigned int c = 0; c < shp.getWidth(); c++)
+				rowbytes[c] = row[c] ? 255 : 0;
+			ok = std::fwrite(rowbytes.data(),1,rowbytes.size(),file) == rowbytes.size();
+		}
+	}
+
+	if(std::fclose(file) != 0 || !ok)
+		throw std::logic_error("fileio::WriteMaskFile : cannot write " + filename);
+}
+
+void fileio::WriteMaskFile(const shape::PackedShape<2>::Ptr packsh, const std::string &filename)
+{
+	FILE *file = std::fopen(filename.c_str(),"wb");
+	if(!file)
+		throw std::logic_error("fileio::WriteMaskFile : cannot open " + filename);
+
+	const shape::PackedShape<2> &shp = *packsh;
+	MaskHeader header = BuildHeader(shp.getWidth(),shp.getHeight(),shp.getFrame(),MaskEncoding::packed);
+	std::size_t nbwords = (std::size_t)shp.getRowWords() * shp.getHeight();
+	bool ok = std::fwrite(&header,sizeof(MaskHeader),1,file) == 1 &&
+			  std::fwrite(shp.getData(),sizeof(uint64_t),nbwords,file) == nbwords;
+
+	if(std::fclose(file) != 0 || !ok)
+		throw std::logic_error("fileio::WriteMaskFile : cannot write " + filename);
+}
+
+bool fileio::GetMaskEncoding(const std::string &filename, MaskEncoding &encoding)
+{
+	FILE *file = std::fopen(filename.c_str(),"rb");
+	if(!file)
+		return false;
+
+	MaskHeader header;
+	bool ok = std::fread(&header,sizeof(MaskHeader),1,file) == 1 &&
+			  std::memcmp(header.magic,"EVSK",4) == 0 && header.version == MaskVersion &&
+			  header.encoding <= (uint32_t)MaskEncoding::packed;
+	std::fclose(file);
+
+	if(ok)
+		encoding = (MaskEncoding)header.encoding;
+	return ok;
+}
+
+shape::DiscreteShape<2>::Ptr fileio::MapMaskFile(const std::string &filename)
+{
+	shape::DiscreteShape<2>::Ptr dissh;
+
+	MaskHeader header;
+	std::shared_ptr<MaskMapping> mapping = MapFile(filename,MaskEncoding::bytes,header);
+	if(mapping)
+	{
+		unsigned char *data = (unsigned char*)mapping->addr + sizeof(MaskHeader);
+		dissh = shape::DiscreteShape<2>::Ptr(new shape::DiscreteShape<2>(data,header.width,header.height,header.width,mapping,HeaderFrame(header)));
+	}
+
+	return dissh;
+}
+
+shape::PackedShape<2>::Ptr fileio::MapPackedMaskFile(const std::string &filename)
+{
+	shape::PackedShape<2>::Ptr packsh;
+
+	MaskHeader header;
+	std::shared_ptr<MaskMapping> mapping = MapFile(filename,MaskEncoding::packed,header);
+	if(mapping)
+	{
+		uint64_t *data = (uint64_t*)((unsigned char*)mapping->addr + sizeof(MaskHeader));
+
+		// bits past the width are zero in a packed shape, which the popcounts over whole words rely on
+		const std::size_t rowwords = ((std::size_t)header.width+63)/64;
+		if(header.width % 64 != 0)
+		{
+			const uint64_t padding = ~(uint64_t)0 << (header.width % 64);
+			for(unsigned int l = 0; l < header.height; l++)
+				if(data[rowwords * l + rowwords-1] & padding)
+					throw std::logic_error("fileio::MapPackedMaskFile : padding bits are not zero");
+		}
+
+		packsh = shape::PackedShape<2>::Ptr(new shape::PackedShape<2>(data,header.width,header.height,mapping,HeaderFrame(header)));
+	}
+
+	return packsh;
+}
@@ -0,0 +1,108 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file MaskFile.h
+ *  \brief Defines the native mask file format, read by memory mapping
+ *  \author Bastien Durix
+ */
+
+#ifndef _MASKFILE_H_
+#define _MASKFILE_H_
+
+#include <shape/DiscreteShape.h>
+#include <shape/PackedShape.h>
+#include <string>
+
+/**
+ *  \brief Gives file input and output functions
+ */
+namespace fileio
+{
+	/**
+	 *  \brief Pixels encoding of a mask file
+	 */
+	enum class MaskEncoding : unsigned int
+	{
+		bytes = 0,  /**< one byte per pixel, 0 outside of the shape */
+		packed = 1  /**< one bit per pixel, rows of 64 bits words as in shape::PackedShape */
+	};
+
+	/**
+	 *  \brief Writes a mask file
+	 *
+	 *  \details The file starts with a 72 bytes header: "EVSK" magic, version, width, height and encoding
+	 *           as 32 bits integers, 4 reserved bytes, then the frame origin and basis vectors as 6 doubles.
+	 *           Rows follow without any padding between them. All values are in the host byte order.
+	 *
+	 *  \param dissh    discrete shape to write
+	 *  \param filename mask filename
+	 *  \param encoding pixels encoding
+	 */
+	void WriteMaskFile(const shape::DiscreteShape<2>::Ptr dissh, const std::string &filename, MaskEncoding encoding = MaskEncoding::packed);
+
+	/**
+	 *  \brief Writes a bit packed mask file
+	 *
+	 *  \param packsh   bit packed shape to write
+	 *  \param filename mask filename
+	 */
+	void WriteMaskFile(const shape::PackedShape<2>::Ptr packsh, const std::string &filename);
+
+	/**
+	 *  \brief Reads the pixels encoding of a mask file
+	 *
+	 *  \param filename mask filename
+	 *  \param encoding encoding of the file, set if it is a mask file
+	 *
+	 *  \return true if the file is a mask file of a supported version
+	 */
+	bool GetMaskEncoding(const std::string &filename, MaskEncoding &encoding);
+
+	/**
+	 *  \brief Maps a mask file with one byte per pixel, as a discrete shape view
+	 *
+	 *  \details The file is mapped copy on write: modifying the shape does not modify the file.
+	 *           Throws if the file is not a mask file with this encoding.
+	 *
+	 *  \param filename mask filename
+	 *
+	 *  \return view on the mapped file, null if the file cannot be opened
+	 */
+	shape::DiscreteShape<2>::Ptr MapMaskFile(const std::string &filename);
+
+	/**
+	 *  \brief Maps a bit packed mask file, as a packed shape view
+	 *
+	 *  \details The file is mapped copy on write: modifying the shape does not modify the file.
+	 *           Throws if the file is not a mask file with this encoding, or if the bits past the width
+	 *           of a row are not zero.
+	 *
+	 *  \param filename mask filename
+	 *
+	 *  \return view on the mapped file, null if the file cannot be opened
+	 */
+	shape::PackedShape<2>::Ptr MapPackedMaskFile(const std::string &filename);
+}
+
+#endif //_MASKFILE_H_
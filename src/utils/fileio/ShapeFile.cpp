@@ -0,0 +1,608 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file ShapeFile.cpp
+ *  \brief Defines discrete shape image readers, binarizing the image while it is decoded
+ *  \author Bastien Durix
+ */
+
+#include "ShapeFile.h"
+#include "MaskFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <csetjmp>
+#include <cctype>
+#include <stdexcept>
+#include <png.h>
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgcodecs/imgcodecs.hpp>
+
+/**
+ *  \brief PBM and PGM reader
+ */
+class PNMReader : public fileio::ShapeReader
+{
+	protected:
+		/**
+		 *  \brief Image file
+		 */
+		FILE *m_file;
+
+		/**
+		 *  \brief Format number, 1 and 2 for plain PBM and PGM, 4 and 5 for raw PBM and PGM
+		 */
+		int m_format;
+
+		/**
+		 *  \brief Maximal gray value
+		 */
+		unsigned int m_maxval;
+
+		/**
+		 *  \brief Raw bytes of the current row
+		 */
+		std::vector<unsigned char> m_raw;
+
+		/**
+		 *  \brief True if raw values are read, without scaling
+		 */
+		bool m_labels;
+
+		/**
+		 *  \brief Reads the next character, skipping comments
+		 *
+		 *  \return next character, EOF at the end of the file
+		 */
+		int nextChar()
+		{
+			int ch = std::getc(m_file);
+			if(ch == '#')
+				while(ch != '\n' && ch != EOF)
+					ch = std::getc(m_file);
+			return ch;
+		}
+
+		/**
+		 *  \brief Reads an ascii unsigned integer
+		 *
+		 *  \return read integer
+		 */
+		unsigned int nextInt()
+		{
+			int ch = nextChar();
+			while(ch != EOF && std::isspace(ch))
+				ch = nextChar();
+			if(ch == EOF || !std::isdigit(ch))
+				throw std::logic_error("fileio::PNMReader : malformed file");
+			
+			unsigned int val = 0;
+			while(ch != EOF && std::isdigit(ch))
+			{
+				val = 10*val + (ch - '0');
+				ch = std::getc(m_file);
+			}
+			return val;
+		}
+
+		/**
+		 *  \brief Scales a gray value to [0,255]
+		 *
+		 *  \param val gray value, in [0,m_maxval]
+		 *
+		 *  \return scaled gray value
+		 */
+		unsigned char scale(unsigned int val) const
+		{
+			if(val > m_maxval)
+				val = m_maxval;
+			if(m_labels)
+				return (unsigned char)val;
+			return m_maxval == 255 ? (unsigned char)val : (unsigned char)((val * 255 + m_maxval/2) / m_maxval);
+		}
+
+		void decodeRow(unsigned char *gray)
+		{
+			switch(m_format)
+			{
+				case 1:
+					for(unsigned int c = 0; c < m_width; c++)
+					{
+						int ch = nextChar();
+						while(ch != EOF && std::isspace(ch))
+							ch = nextChar();
+						if(ch != '0' && ch != '1')
+							throw std::logic_error("fileio::PNMReader::decodeRow : truncated file");
+						gray[c] = m_labels ? (ch == '1') : (ch == '1' ? 0 : 255);
+					}
+					break;
+				case 2:
+					for(unsigned int c = 0; c < m_width; c++)
+						gray[c] = scale(nextInt());
+					break;
+				case 4:
+					if(std::fread(m_raw.data(),1,m_raw.size(),m_file) != m_raw.size())
+						throw std::logic_error("fileio::PNMReader::decodeRow : truncated file");
+					for(unsigned int c = 0; c < m_width; c++)
+					{
+						unsigned char bit = (m_raw[c/8] >> (7 - c%8)) & 1;
+						gray[c] = m_labels ? bit : (bit ? 0 : 255);
+					}
+					break;
+				case 5:
+					if(std::fread(m_raw.data(),1,m_raw.size(),m_file) != m_raw.size())
+						throw std::logic_error("fileio::PNMReader::decodeRow : truncated file");
+					if(m_maxval < 256)
+						for(unsigned int c = 0; c < m_width; c++)
+							gray[c] = scale(m_raw[c]);
+					else
+						for(unsigned int c = 0; c < m_width; c++)
+							gray[c] = scale(((unsigned int)m_raw[2*c] << 8) | m_raw[2*c+1]);
+					break;
+			}
+		}
+
+	public:
+		/**
+		 *  \brief Constructor, reads the header
+		 *
+		 *  \param file    opened image file, positioned after the magic number
+		 *  \param format  format number
+		 *  \param options reading options
+		 */
+		PNMReader(FILE *file, int format, const fileio::OptionsReadShape &options) :
+			fileio::ShapeReader(options), m_file(file), m_format(format), m_maxval(1), m_raw(0), m_labels(options.labels)
+		{
+			try
+			{
+				m_width = nextInt();
+				m_height = nextInt();
+				if(m_format == 2 || m_format == 5)
+					m_maxval = nextInt();
+				if(m_maxval == 0 || m_maxval > 65535)
+					throw std::logic_error("fileio::PNMReader : wrong maximal value");
+				if(m_labels && m_maxval > 255)
+					throw std::logic_error("fileio::PNMReader : labels above 255");
+			}
+			catch(...)
+			{
+				std::fclose(m_file);
+				throw;
+			}
+			// one whitespace character has been read after the header
+
+			if(m_format == 4)
+				m_raw.resize((m_width+7)/8);
+			else if(m_format == 5)
+				m_raw.resize(m_maxval < 256 ? m_width : 2*m_width);
+			m_gray.resize(m_width);
+		}
+
+		/**
+		 *  \brief Destructor
+		 */
+		~PNMReader()
+		{
+			std::fclose(m_file);
+		}
+};
+
+/**
+ *  \brief PNG reader
+ *
+ *  \details Interlaced images are decoded entirely on the first row, the other ones one row at a time
+ */
+class PNGReader : public fileio::ShapeReader
+{
+	protected:
+		/**
+		 *  \brief Image file
+		 */
+		FILE *m_file;
+
+		/**
+		 *  \brief PNG decoder
+		 */
+		png_structp m_png;
+
+		/**
+		 *  \brief PNG image information
+		 */
+		png_infop m_info;
+
+		/**
+		 *  \brief Gray levels of the whole image, for interlaced images
+		 */
+		std::vector<unsigned char> m_image;
+
+		/**
+		 *  \brief True if the image is interlaced
+		 */
+		bool m_interlaced;
+
+		void decodeRow(unsigned char *gray)
+		{
+			if(m_interlaced)
+			{
+				if(m_row == 0)
+				{
+					m_image.resize((std::size_t)m_width * m_height);
+					std::vector<png_bytep> rows(m_height);
+					for(unsigned int l = 0; l < m_height; l++)
+						rows[l] = &m_image[(std::size_t)m_width * l];
+					if(setjmp(png_jmpbuf(m_png)))
+						throw std::logic_error("fileio::PNGReader::decodeRow : corrupted file");
+					png_read_image(m_png,rows.data());
+				}
+				std::memcpy(gray,&m_image[(std::size_t)m_width * m_row],m_width);
+			}
+			else
+			{
+				if(setjmp(png_jmpbuf(m_png)))
+					throw std::logic_error("fileio::PNGReader::decodeRow : corrupted file");
+				png_read_row(m_png,gray,nullptr);
+			}
+		}
+
+	public:
+		/**
+		 *  \brief Constructor, reads the header
+		 *
+		 *  \param file    opened image file, positioned after the signature
+		 *  \param options reading options
+		 */
+		PNGReader(FILE *file, const fileio::OptionsReadShape &options) :
+			fileio::ShapeReader(options), m_file(file), m_png(nullptr), m_info(nullptr), m_image(0), m_interlaced(false)
+		{
+			m_png = png_create_read_struct(PNG_LIBPNG_VER_STRING,nullptr,nullptr,nullptr);
+			if(m_png)
+				m_info = png_create_info_struct(m_png);
+			if(!m_info || setjmp(png_jmpbuf(m_png)))
+			{
+				png_destroy_read_struct(&m_png,&m_info,nullptr);
+				std::fclose(m_file);
+				throw std::logic_error("fileio::PNGReader : corrupted file");
+			}
+
+			png_init_io(m_png,m_file);
+			png_set_sig_bytes(m_png,8);
+			png_read_info(m_png,m_info);
+
+			int colortype = png_get_color_type(m_png,m_info);
+			int bitdepth = png_get_bit_depth(m_png,m_info);
+			// a tRNS chunk becomes an alpha channel when the palette is expanded
+			bool alpha = (colortype & PNG_COLOR_MASK_ALPHA) || png_get_valid(m_png,m_info,PNG_INFO_tRNS);
+
+			if(options.labels)
+			{
+				// raw 8 bits values: palette indices or gray values
+				if((colortype & PNG_COLOR_MASK_COLOR) && colortype != PNG_COLOR_TYPE_PALETTE)
+				{
+					png_destroy_read_struct(&m_png,&m_info,nullptr);
+					std::fclose(m_file);
+					throw std::logic_error("fileio::PNGReader : colored labels");
+				}
+				if(bitdepth == 16)
+				{
+					png_destroy_read_struct(&m_png,&m_info,nullptr);
+					std::fclose(m_file);
+					throw std::logic_error("fileio::PNGReader : labels above 255");
+				}
+				if(bitdepth < 8)
+					png_set_packing(m_png);
+				if(alpha)
+					png_set_strip_alpha(m_png);
+			}
+			else
+			{
+				// 8 bits gray levels, whatever the input
+				if(colortype == PNG_COLOR_TYPE_PALETTE)
+					png_set_palette_to_rgb(m_png);
+				if(colortype == PNG_COLOR_TYPE_GRAY && bitdepth < 8)
+					png_set_expand_gray_1_2_4_to_8(m_png);
+				if(bitdepth == 16)
+					png_set_strip_16(m_png);
+				if(alpha)
+					png_set_strip_alpha(m_png);
+				if(colortype == PNG_COLOR_TYPE_PALETTE || (colortype & PNG_COLOR_MASK_COLOR))
+					png_set_rgb_to_gray_fixed(m_png,1,29900,58700);
+			}
+			m_interlaced = png_set_interlace_handling(m_png) > 1;
+			png_read_update_info(m_png,m_info);
+
+			m_width = png_get_image_width(m_png,m_info);
+			m_height = png_get_image_height(m_png,m_info);
+			if(png_get_rowbytes(m_png,m_info) != m_width)
+			{
+				png_destroy_read_struct(&m_png,&m_info,nullptr);
+				std::fclose(m_file);
+				throw std::logic_error("fileio::PNGReader : unsupported pixel format");
+			}
+			m_gray.resize(m_width);
+		}
+
+		/**
+		 *  \brief Destructor
+		 */
+		~PNGReader()
+		{
+			png_destroy_read_struct(&m_png,&m_info,nullptr);
+			std::fclose(m_file);
+		}
+};
+
+/**
+ *  \brief Mask file reader, on the mapped file
+ */
+class MaskReader : public fileio::ShapeReader
+{
+	protected:
+		/**
+		 *  \brief Mapped shape, for masks with one byte per pixel
+		 */
+		shape::DiscreteShape<2>::Ptr m_dissh;
+
+		/**
+		 *  \brief Mapped shape, for bit packed masks
+		 */
+		shape::PackedShape<2>::Ptr m_packsh;
+
+		/**
+		 *  \brief Value of the pixels in the shape, 1 for labels and 255 for gray levels
+		 */
+		unsigned char m_inval;
+
+		void decodeRow(unsigned char *gray)
+		{
+			if(m_dissh)
+			{
+				const shape::DiscreteShape<2> &shp = *m_dissh;
+				const unsigned char *row = shp.getData() + shp.getStride() * m_row;
+				for(unsigned int c = 0; c < m_width; c++)
+					gray[c] = row[c] ? m_inval : 0;
+			}
+			else
+			{
+				const shape::PackedShape<2> &shp = *m_packsh;
+				const uint64_t *words = shp.getData() + (std::size_t)shp.getRowWords() * m_row;
+				for(unsigned int c = 0; c < m_width; c++)
+					gray[c] = ((words[c/64] >> (c%64)) & 1) ? m_inval : 0;
+			}
+		}
+
+	public:
+		/**
+		 *  \brief Constructor, maps the file
+		 *
+		 *  \param filename mask filename
+		 *  \param encoding pixels encoding of the file
+		 *  \param options  reading options
+		 */
+		MaskReader(const std::string &filename, fileio::MaskEncoding encoding, const fileio::OptionsReadShape &options) :
+			fileio::ShapeReader(options), m_inval(options.labels ? 1 : 255)
+		{
+			if(encoding == fileio::MaskEncoding::bytes)
+			{
+				m_dissh = fileio::MapMaskFile(filename);
+				if(!m_dissh)
+					throw std::logic_error("fileio::MaskReader : cannot map the file");
+				m_width = m_dissh->getWidth();
+				m_height = m_dissh->getHeight();
+			}
+			else
+			{
+				m_packsh = fileio::MapPackedMaskFile(filename);
+				if(!m_packsh)
+					throw std::logic_error("fileio::MaskReader : cannot map the file");
+				m_width = m_packsh->getWidth();
+				m_height = m_packsh->getHeight();
+			}
+			m_gray.resize(m_width);
+		}
+};
+
+/**
+ *  \brief Reader of the other image formats, decoded entirely with OpenCV
+ */
+class ImageReader : public fileio::ShapeReader
+{
+	protected:
+		/**
+		 *  \brief Decoded image
+		 */
+		cv::Mat m_img;
+
+		void decodeRow(unsigned char *gray)
+		{
+			std::memcpy(gray,m_img.ptr<unsigned char>(m_row),m_width);
+		}
+
+	public:
+		/**
+		 *  \brief Constructor, decodes the image
+		 *
+		 *  \param img     decoded image, not empty
+		 *  \param options reading options
+		 */
+		ImageReader(const cv::Mat &img, const fileio::OptionsReadShape &options) :
+			fileio::ShapeReader(options), m_img(img)
+		{
+			if(m_img.channels() != 1 || m_img.depth() != CV_8U)
+				throw std::logic_error("fileio::ImageReader : labels image is colored or has values above 255");
+			m_width = m_img.cols;
+			m_height = m_img.rows;
+			m_gray.resize(m_width);
+		}
+};
+
+fileio::ShapeReader::ShapeReader(const OptionsReadShape &options) :
+	m_width(0), m_height(0), m_row(0), m_threshold(options.threshold), m_gray(0)
+{}
+
+fileio::ShapeReader::~ShapeReader()
+{}
+
+unsigned int fileio::ShapeReader::getWidth() const
+{
+	return m_width;
+}
+
+unsigned int fileio::ShapeReader::getHeight() const
+{
+	return m_height;
+}
+
+unsigned int fileio::ShapeReader::getRow() const
+{
+	return m_row;
+}
+
+void fileio::ShapeReader::readRow(unsigned char *row)
+{
+	if(m_row >= m_height)
+		throw std::logic_error("fileio::ShapeReader::readRow : all rows have been read");
+	decodeRow(m_gray.data());
+	m_row++;
+
+	for(unsigned int c = 0; c < m_width; c++)
+		row[c] = m_gray[c] > m_threshold ? 255 : 0;
+}
+
+void fileio::ShapeReader::readRow(uint64_t *words)
+{
+	if(m_row >= m_height)
+		throw std::logic_error("fileio::ShapeReader::readRow : all rows have been read");
+	decodeRow(m_gray.data());
+	m_row++;
+
+	for(unsigned int w = 0; w < (m_width+63)/64; w++)
+	{
+		uint64_t word = 0;
+		unsigned int nbbits = std::min(m_width - 64*w, 64u);
+		for(unsigned int b = 0; b < nbbits; b++)
+			word |= (uint64_t)(m_gray[64*w + b] > m_threshold) << b;
+		words[w] = word;
+	}
+}
+
+void fileio::ShapeReader::readGrayRow(unsigned char *gray)
+{
+	if(m_row >= m_height)
+		throw std::logic_error("fileio::ShapeReader::readGrayRow : all rows have been read");
+	decodeRow(gray);
+	m_row++;
+}
+
+fileio::ShapeReader::Ptr fileio::OpenShapeReader(const std::string &filename, const OptionsReadShape &options)
+{
+	ShapeReader::Ptr reader;
+
+	MaskEncoding encoding;
+	if(GetMaskEncoding(filename,encoding))
+		return ShapeReader::Ptr(new MaskReader(filename,encoding,options));
+	
+	FILE *file = std::fopen(filename.c_str(),"rb");
+	if(file)
+	{
+		unsigned char magic[8];
+		std::size_t nbread = std::fread(magic,1,2,file);
+		
+		if(nbread == 2 && magic[0] == 'P' && (magic[1] == '1' || magic[1] == '2' || magic[1] == '4' || magic[1] == '5'))
+			reader = ShapeReader::Ptr(new PNMReader(file,magic[1] - '0',options));
+		else if(nbread == 2 && std::fread(magic+2,1,6,file) == 6 && png_sig_cmp(magic,0,8) == 0)
+			reader = ShapeReader::Ptr(new PNGReader(file,options));
+		else
+			std::fclose(file);
+	}
+
+	// other formats (JPEG, TIFF, BMP...) are decoded entirely by OpenCV
+	if(!reader)
+	{
+		cv::Mat img = cv::imread(filename,options.labels ? cv::IMREAD_UNCHANGED : cv::IMREAD_GRAYSCALE);
+		if(!img.empty())
+			reader = ShapeReader::Ptr(new ImageReader(img,options));
+	}
+	
+	return reader;
+}
+
+shape::DiscreteShape<2>::Ptr fileio::ReadShape(const std::string &filename, const OptionsReadShape &options)
+{
+	shape::DiscreteShape<2>::Ptr dissh;
+
+	// binary masks with one byte per pixel are used in place, without decoding
+	MaskEncoding encoding;
+	if(GetMaskEncoding(filename,encoding) && encoding == MaskEncoding::bytes)
+		return MapMaskFile(filename);
+
+	ShapeReader::Ptr reader = OpenShapeReader(filename,options);
+	if(reader)
+	{
+		dissh = shape::DiscreteShape<2>::Ptr(new shape::DiscreteShape<2>(reader->getWidth(),reader->getHeight()));
+		unsigned char *disc = dissh->getWritableData();
+		for(unsigned int l = 0; l < reader->getHeight(); l++)
+			reader->readRow(disc + dissh->getStride() * l);
+	}
+
+	return dissh;
+}
+
+shape::PackedShape<2>::Ptr fileio::ReadPackedShape(const std::string &filename, const OptionsReadShape &options)
+{
+	shape::PackedShape<2>::Ptr packsh;
+
+	// bit packed masks are used in place, without decoding
+	MaskEncoding encoding;
+	if(GetMaskEncoding(filename,encoding) && encoding == MaskEncoding::packed)
+		return MapPackedMaskFile(filename);
+
+	ShapeReader::Ptr reader = OpenShapeReader(filename,options);
+	if(reader)
+	{
+		packsh = shape::PackedShape<2>::Ptr(new shape::PackedShape<2>(reader->getWidth(),reader->getHeight()));
+		uint64_t *words = packsh->getContainer().data();
+		for(unsigned int l = 0; l < reader->getHeight(); l++)
+			reader->readRow(words + (std::size_t)packsh->getRowWords() * l);
+	}
+
+	return packsh;
+}
+
+shape::LabelShape<2>::Ptr fileio::ReadLabelShape(const std::string &filename)
+{
+	shape::LabelShape<2>::Ptr labsh;
+
+	ShapeReader::Ptr reader = OpenShapeReader(filename,OptionsReadShape(1,true));
+	if(reader)
+	{
+		labsh = shape::LabelShape<2>::Ptr(new shape::LabelShape<2>(reader->getWidth(),reader->getHeight()));
+		unsigned char *labels = labsh->getContainer().data();
+		for(unsigned int l = 0; l < reader->getHeight(); l++)
+			reader->readGrayRow(labels + (std::size_t)reader->getWidth() * l);
+	}
+
+	return labsh;
+}
@@ -0,0 +1,233 @@
+/*
+Copyright (c) 2016 Bastien Durix
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ *  \file ShapeFile.h
+ *  \brief Defines discrete shape image readers, binarizing the image while it is decoded
+ *  \author Bastien Durix
+ */
+
+#ifndef _SHAPEFILE_H_
+#define _SHAPEFILE_H_
+
+#include <shape/DiscreteShape.h>
+#include <shape/PackedShape.h>
+#include <shape/LabelShape.h>
+#include <shape/RowStream.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ *  \brief Gives file input and output functions
+ */
+namespace fileio
+{
+	/**
+	 *  \brief Shape reading options
+	 */
+	struct OptionsReadShape
+	{
+		/**
+		 *  \brief Pixels whose gray level is strictly above the threshold are in the shape
+		 */
+		unsigned char threshold;
+
+		/**
+		 *  \brief Reads raw label values instead of gray levels
+		 *
+		 *  \details PBM bits and PGM values are kept as they are, palette PNG images give their palette
+		 *           indices and mask files give 1 in the shape. Colored images and values above 255 are rejected.
+		 */
+		bool labels;
+
+		/**
+		 *  \brief Default constructor
+		 */
+		OptionsReadShape(unsigned char threshold_ = 1, bool labels_ = false) :
+			threshold(threshold_), labels(labels_) {}
+	};
+
+	/**
+	 *  \brief Row by row reader of a binarized image
+	 *
+	 *  \details Only one row of the image is decoded at a time. The gray levels are the ones of an image
+	 *           loaded in grayscale: black pixels of a PBM file are 0, white ones are 255, PGM levels are
+	 *           scaled to [0,255] and colored PNG pixels are converted with 0.299 R + 0.587 G + 0.114 B.
+	 *           With the labels option, the raw values of the file are read instead (see OptionsReadShape).
+	 *           The reader is a shape::RowStream, so that images can be evaluated without being loaded.
+	 */
+	class ShapeReader : public shape::RowStream
+	{
+		public:
+			/**
+			 *  \brief Shape reader shared pointer
+			 */
+			using Ptr = std::shared_ptr<ShapeReader>;
+
+		protected:
+			/**
+			 *  \brief Image width
+			 */
+			unsigned int m_width;
+
+			/**
+			 *  \brief Image height
+			 */
+			unsigned int m_height;
+
+			/**
+			 *  \brief Next row to read
+			 */
+			unsigned int m_row;
+
+			/**
+			 *  \brief Binarization threshold
+			 */
+			unsigned char m_threshold;
+
+			/**
+			 *  \brief Gray levels of the current row
+			 */
+			std::vector<unsigned char> m_gray;
+
+			/**
+			 *  \brief Constructor
+			 *
+			 *  \param options reading options
+			 */
+			ShapeReader(const OptionsReadShape &options);
+
+			/**
+			 *  \brief Decodes the next row of the image
+			 *
+			 *  \param gray gray levels of the row, of size m_width
+			 */
+			virtual void decodeRow(unsigned char *gray) = 0;
+
+		public:
+			/**
+			 *  \brief Destructor
+			 */
+			virtual ~ShapeReader();
+
+			/**
+			 *  \brief Width getter
+			 *
+			 *  \return width of the image
+			 */
+			virtual unsigned int getWidth() const;
+
+			/**
+			 *  \brief Height getter
+			 *
+			 *  \return height of the image
+			 */
+			virtual unsigned int getHeight() const;
+
+			/**
+			 *  \brief Next row getter
+			 *
+			 *  \return index of the next row to read
+			 */
+			unsigned int getRow() const;
+
+			/**
+			 *  \brief Reads the next row, one byte per pixel
+			 *
+			 *  \param row pixels of the row, 255 in the shape and 0 outside
+			 */
+			virtual void readRow(unsigned char *row);
+
+			/**
+			 *  \brief Reads the next row, one bit per pixel
+			 *
+			 *  \param words words of the row, as in shape::PackedShape (padding bits are cleared)
+			 */
+			void readRow(uint64_t *words);
+
+			/**
+			 *  \brief Reads the next row, without binarization
+			 *
+			 *  \param gray gray levels of the row
+			 */
+			void readGrayRow(unsigned char *gray);
+	};
+
+	/**
+	 *  \brief Opens a binarized image reader
+	 *
+	 *  \details PBM and PGM (plain or raw) and PNG images are supported, the format is found from the
+	 *           first bytes of the file. Mask files (see MaskFile.h) are mapped instead of decoded, their
+	 *           pixels are read with gray level 255. The other formats readable by OpenCV (JPEG, TIFF, BMP...)
+	 *           are decoded entirely with cv::imread before being read row by row. Throws if the header is
+	 *           malformed.
+	 *
+	 *  \param filename image filename
+	 *  \param options  reading options
+	 *
+	 *  \return reader, null if the file cannot be opened or its format is not supported
+	 */
+	ShapeReader::Ptr OpenShapeReader(const std::string &filename, const OptionsReadShape &options = OptionsReadShape());
+
+	/**
+	 *  \brief Reads a discrete shape from an image
+	 *
+	 *  \details A mask file with one byte per pixel is returned as a view on the mapped file (see MapMaskFile),
+	 *           the threshold does not apply since a mask is already binary.
+	 *
+	 *  \param filename image filename
+	 *  \param options  reading options
+	 *
+	 *  \return discrete shape, null if the file cannot be opened or its format is not supported
+	 */
+	shape::DiscreteShape<2>::Ptr ReadShape(const std::string &filename, const OptionsReadShape &options = OptionsReadShape());
+
+	/**
+	 *  \brief Reads a bit packed discrete shape from an image
+	 *
+	 *  \details A bit packed mask file is returned as a view on the mapped file (see MapPackedMaskFile),
+	 *           the threshold does not apply since a mask is already binary.
+	 *
+	 *  \param filename image filename
+	 *  \param options  reading options
+	 *
+	 *  \return bit packed shape, null if the file cannot be opened or its format is not supported
+	 */
+	shape::PackedShape<2>::Ptr ReadPackedShape(const std::string &filename, const OptionsReadShape &options = OptionsReadShape());
+
+	/**
+	 *  \brief Reads a multi-label shape from an image
+	 *
+	 *  \details The label of each pixel is its raw value in the file: PBM bit, PGM value, palette index of
+	 *           a PNG image or raw value of an image read with OpenCV. Throws if the image is colored or has values above 255.
+	 *
+	 *  \param filename image filename
+	 *
+	 *  \return label shape, null if the file cannot be opened or its format is not supported
+	 */
+	shape::LabelShape<2>::Ptr ReadLabelShape(const std::string &filename);
+}
+
+#endif //_SHAPEFILE_H_